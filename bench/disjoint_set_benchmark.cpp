@@ -0,0 +1,165 @@
+// MIT License
+//
+// Copyright (c) 2020 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Unions and finds per second of sax::basic_dynamic_disjoint_set, for every combination of find policy and union
+// policy, over three union sequences:
+//
+//     random:   unite ( x, y ) for uniformly random x and y,
+//     chain:    unite ( i, i + 1 ) for all i, in order,
+//     binomial: unite ( i, i + s ) for all i divisible by 2 s, for s = 1, 2, 4, ... (the deepest trees union by rank
+//               and union by size allow).
+//
+// After the unions, as many uniformly random finds are timed. Without arguments it prints a table over a population of
+// 2 ^ 20, with "--size <n>" over a population of n.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <chrono>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <sax/detail/benchmark.hpp>
+#include <sax/disjoint_set.hpp>
+#include <sax/sfc.hpp>
+
+namespace {
+
+using sax::benchmark_detail::type_tag;
+
+struct disjoint_set_benchmark_result {
+    char const * find_policy;
+    char const * union_policy;
+    char const * workload;
+    double munions_per_second; // unite ( x, y ), in millions.
+    double mfinds_per_second;  // find ( x ), in millions.
+};
+
+constexpr std::uint32_t population_size = std::uint32_t{ 1 } << 20;
+
+struct workload {
+    char const * name;
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> unions;
+    std::vector<std::uint32_t> finds;
+};
+
+// A uniformly random index below size_ (Lemire's multiply-shift, the bias is negligible for the benchmark).
+[[nodiscard]] std::uint32_t random_index ( sax::sfc64 & rng_, std::uint32_t const size_ ) noexcept {
+    return static_cast<std::uint32_t> ( ( ( rng_ ( ) >> 32 ) * size_ ) >> 32 );
+}
+
+[[nodiscard]] std::vector<workload> make_workloads ( std::uint32_t const size_ ) {
+    sax::sfc64 rng;
+    std::vector<workload> workloads ( 3 );
+    workloads[ 0 ].name = "random";
+    workloads[ 0 ].unions.reserve ( size_ );
+    for ( std::uint32_t i = 0; i < size_; ++i )
+        workloads[ 0 ].unions.emplace_back ( random_index ( rng, size_ ), random_index ( rng, size_ ) );
+    workloads[ 1 ].name = "chain";
+    workloads[ 1 ].unions.reserve ( size_ );
+    for ( std::uint32_t i = 0; i + 1u < size_; ++i )
+        workloads[ 1 ].unions.emplace_back ( i, i + 1u );
+    workloads[ 2 ].name = "binomial";
+    workloads[ 2 ].unions.reserve ( size_ );
+    for ( std::uint64_t s = 1u; s < size_; s *= 2u )
+        for ( std::uint64_t i = 0u; i + s < size_; i += 2u * s )
+            workloads[ 2 ].unions.emplace_back ( static_cast<std::uint32_t> ( i ), static_cast<std::uint32_t> ( i + s ) );
+    for ( workload & w : workloads ) {
+        w.finds.reserve ( size_ );
+        for ( std::uint32_t i = 0; i < size_; ++i )
+            w.finds.push_back ( random_index ( rng, size_ ) );
+    }
+    return workloads;
+}
+
+template<typename FindPolicy, typename UnionPolicy>
+using set_tag = type_tag<sax::basic_dynamic_disjoint_set<std::uint32_t, FindPolicy, UnionPolicy>>;
+
+// Calls f_ ( find_name, union_name, type_tag<Set> ) for every combination of policies.
+template<typename Function>
+void for_each_policy ( Function f_ ) {
+    using namespace sax::find_policy;
+    using namespace sax::union_policy;
+    f_ ( "path_compression", "by_rank", set_tag<path_compression, by_rank> { } );
+    f_ ( "path_compression", "by_size", set_tag<path_compression, by_size> { } );
+    f_ ( "path_halving", "by_rank", set_tag<path_halving, by_rank> { } );
+    f_ ( "path_halving", "by_size", set_tag<path_halving, by_size> { } );
+    f_ ( "path_splitting", "by_rank", set_tag<path_splitting, by_rank> { } );
+    f_ ( "path_splitting", "by_size", set_tag<path_splitting, by_size> { } );
+}
+
+// Times the unions of workload_ on a fresh set of size_ singletons, then its finds.
+template<typename Set>
+[[nodiscard]] disjoint_set_benchmark_result benchmark_disjoint_set ( char const * find_name_, char const * union_name_,
+                                                                     workload const & workload_, std::uint32_t const size_ ) {
+    Set set ( size_ );
+    std::uint64_t sink = 0u;
+    auto const t0      = std::chrono::steady_clock::now ( );
+    for ( auto const & [ x, y ] : workload_.unions )
+        sink += set.unite ( x, y );
+    auto const t1 = std::chrono::steady_clock::now ( );
+    for ( std::uint32_t const x : workload_.finds )
+        sink += set.find ( x );
+    auto const t2                     = std::chrono::steady_clock::now ( );
+    sax::benchmark_detail::keep_alive = sink;
+    return { find_name_, union_name_, workload_.name,
+             sax::benchmark_detail::millions_per_second ( workload_.unions.size ( ), t1 - t0 ),
+             sax::benchmark_detail::millions_per_second ( workload_.finds.size ( ), t2 - t1 ) };
+}
+
+// Prints a table of all policies and workloads to out_.
+void benchmark_disjoint_sets ( std::FILE * out_, std::uint32_t const size_ ) {
+    std::vector<workload> const workloads = make_workloads ( size_ );
+    std::fprintf ( out_, "%-17s %-8s %-9s %10s %10s\n", "find", "union", "workload", "Munions/s", "Mfinds/s" );
+    for_each_policy ( [ out_, size_, &workloads ] ( char const * find_name_, char const * union_name_, auto tag_ ) {
+        using set_type = typename decltype ( tag_ )::type;
+        for ( workload const & w : workloads ) {
+            disjoint_set_benchmark_result const r = benchmark_disjoint_set<set_type> ( find_name_, union_name_, w, size_ );
+            std::fprintf ( out_, "%-17s %-8s %-9s %10.3f %10.3f\n", r.find_policy, r.union_policy, r.workload,
+                           r.munions_per_second, r.mfinds_per_second );
+            std::fflush ( out_ );
+        }
+    } );
+}
+
+} // namespace
+
+int main ( int argc, char ** argv ) {
+    if ( 1 == argc ) {
+        benchmark_disjoint_sets ( stdout, population_size );
+        return EXIT_SUCCESS;
+    }
+    if ( 3 == argc and not std::strcmp ( argv[ 1 ], "--size" ) ) {
+        long long const size = std::atoll ( argv[ 2 ] );
+        if ( size > 1 and size <= static_cast<long long> ( std::numeric_limits<std::uint32_t>::max ( ) ) ) {
+            benchmark_disjoint_sets ( stdout, static_cast<std::uint32_t> ( size ) );
+            return EXIT_SUCCESS;
+        }
+        std::fprintf ( stderr, "invalid population size: %s\n", argv[ 2 ] );
+    }
+    std::fprintf ( stderr, "usage: %s [--size <n>]\n", argv[ 0 ] );
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,151 @@
+// MIT License
+//
+// Copyright (c) 2020 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Throughput and fairness of the sax mutual exclusion locks (and std::mutex, for reference) under full contention, at
+// 1, 2, 4, ... 64 threads. Every thread takes the lock, updates one shared word and releases the lock, in a loop.
+//
+// Without arguments it prints a table of all locks, with "--threads <n>" the thread counts stop at n. The fair locks
+// (TicketLock, MCSLock) hand the lock to a spinning thread, with more threads than cores that thread may not be
+// running, expect their throughput to collapse there.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <sax/detail/benchmark.hpp>
+#include <sax/srwlock.hpp>
+
+namespace {
+
+using sax::benchmark_detail::type_tag;
+
+struct lock_benchmark_result {
+    char const * name;
+    int threads;
+    double mops_per_second; // Acquisitions (lock, update, unlock) per second, all threads, in millions.
+    double fairness;        // The fewest acquisitions of any thread over the most, 1 is perfectly fair.
+};
+
+constexpr int max_threads = 64;
+
+struct alignas ( 64 ) padded_count {
+    std::uint64_t value = 0u;
+};
+
+// Calls f_ ( name, type_tag<Lock> ) for every lock.
+template<typename Function>
+void for_each_lock ( Function f_ ) {
+    f_ ( "SpinLock", type_tag<sax::SpinLock> { } );
+    f_ ( "spin<yield>", type_tag<sax::basic_spin_lock<sax::spin_policy::yield>> { } );
+    f_ ( "spin<park>", type_tag<sax::basic_spin_lock<sax::spin_policy::park>> { } );
+    f_ ( "TicketLock", type_tag<sax::TicketLock> { } );
+    f_ ( "MCSLock", type_tag<sax::MCSLock> { } );
+    f_ ( "SRWLock", type_tag<sax::SRWLock> { } );
+    f_ ( "std::mutex", type_tag<std::mutex> { } );
+}
+
+// Runs threads_ threads contending for one Lock for (about) duration_.
+template<typename Lock>
+[[nodiscard]] lock_benchmark_result benchmark_lock ( char const * name_, int threads_, std::chrono::milliseconds duration_ ) {
+    Lock lock;
+    std::uint64_t shared = 0u; // Protected by lock.
+    std::atomic<int> ready{ 0 };
+    std::atomic<bool> start{ false }, stop{ false };
+    std::vector<padded_count> counts ( static_cast<std::size_t> ( threads_ ) );
+    std::vector<std::thread> workers;
+    workers.reserve ( static_cast<std::size_t> ( threads_ ) );
+    for ( int t = 0; t < threads_; ++t ) {
+        workers.emplace_back ( [ &, t ] {
+            std::uint64_t n = 0u;
+            ready.fetch_add ( 1, std::memory_order_relaxed );
+            while ( not start.load ( std::memory_order_acquire ) )
+                std::this_thread::yield ( );
+            while ( not stop.load ( std::memory_order_relaxed ) ) {
+                lock.lock ( );
+                shared = shared * 6'364'136'223'846'793'005ull + 1'442'695'040'888'963'407ull;
+                lock.unlock ( );
+                ++n;
+            }
+            counts[ static_cast<std::size_t> ( t ) ].value = n;
+        } );
+    }
+    while ( ready.load ( std::memory_order_relaxed ) < threads_ )
+        std::this_thread::yield ( );
+    auto const t0 = std::chrono::steady_clock::now ( );
+    start.store ( true, std::memory_order_release );
+    std::this_thread::sleep_for ( duration_ );
+    stop.store ( true, std::memory_order_relaxed );
+    auto const t1 = std::chrono::steady_clock::now ( );
+    for ( std::thread & w : workers )
+        w.join ( );
+    sax::benchmark_detail::keep_alive = shared;
+    std::uint64_t total = 0u, fewest = ~std::uint64_t{ 0 }, most = 0u;
+    for ( padded_count const & c : counts ) {
+        total += c.value;
+        fewest = std::min ( fewest, c.value );
+        most   = std::max ( most, c.value );
+    }
+    return { name_, threads_, sax::benchmark_detail::millions_per_second ( total, t1 - t0 ),
+             most ? static_cast<double> ( fewest ) / static_cast<double> ( most ) : 0.0 };
+}
+
+// Prints a table of all locks, at 1, 2, 4, ... max_threads_ threads, to out_.
+void benchmark_locks ( std::FILE * out_, int max_threads_,
+                       std::chrono::milliseconds duration_ = std::chrono::milliseconds{ 200 } ) {
+    std::fprintf ( out_, "%-12s %8s %10s %10s\n", "lock", "threads", "Mops/s", "fairness" );
+    for_each_lock ( [ out_, max_threads_, duration_ ] ( char const * name_, auto tag_ ) {
+        using lock_type = typename decltype ( tag_ )::type;
+        for ( int threads = 1; threads <= max_threads_; threads *= 2 ) {
+            lock_benchmark_result const r = benchmark_lock<lock_type> ( name_, threads, duration_ );
+            std::fprintf ( out_, "%-12s %8d %10.3f %10.3f\n", r.name, r.threads, r.mops_per_second, r.fairness );
+            std::fflush ( out_ );
+        }
+    } );
+}
+
+} // namespace
+
+int main ( int argc, char ** argv ) {
+    if ( 1 == argc ) {
+        benchmark_locks ( stdout, max_threads );
+        return EXIT_SUCCESS;
+    }
+    if ( 3 == argc and not std::strcmp ( argv[ 1 ], "--threads" ) ) {
+        int const threads = std::atoi ( argv[ 2 ] );
+        if ( threads > 0 ) {
+            benchmark_locks ( stdout, threads );
+            return EXIT_SUCCESS;
+        }
+        std::fprintf ( stderr, "invalid thread count: %s\n", argv[ 2 ] );
+    }
+    std::fprintf ( stderr, "usage: %s [--threads <n>]\n", argv[ 0 ] );
+    return EXIT_FAILURE;
+}
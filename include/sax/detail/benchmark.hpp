@@ -0,0 +1,54 @@
+// MIT License
+//
+// Copyright (c) 2020 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+
+#include <chrono>
+
+// The common parts of the sax benchmarks.
+
+namespace sax {
+namespace benchmark_detail {
+
+inline volatile std::uint64_t keep_alive = 0u; // Results are written here, so the loops can't be optimized away.
+
+template<typename Duration>
+[[nodiscard]] double nanoseconds ( Duration d_ ) noexcept {
+    return std::chrono::duration<double, std::nano> ( d_ ).count ( );
+}
+
+// Millions of operations per second, from a count of operations and their duration.
+template<typename Duration>
+[[nodiscard]] double millions_per_second ( std::uint64_t count_, Duration d_ ) noexcept {
+    return 1'000.0 * static_cast<double> ( count_ ) / nanoseconds ( d_ );
+}
+
+// Passes a type (a lock, a disjoint set, ...) to a generic lambda, which gets at it with typename decltype ( tag )::type.
+template<typename T>
+struct type_tag {
+    using type = T;
+};
+
+} // namespace benchmark_detail
+} // namespace sax
@@ -0,0 +1,61 @@
+// MIT License
+//
+// Copyright (c) 2020 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <cstdint>
+
+#if defined( _MSC_VER ) and not defined( __clang__ ) and defined( _M_X64 )
+#    include <intrin.h>
+#    pragma intrinsic( _umul128 )
+#endif
+
+namespace sax {
+namespace detail {
+
+// The high 64 bits of x_ * y_, the low 64 bits in l_ (the full product, for Lemire's bounded draws and fastmod, the
+// hash mixes, ...).
+[[nodiscard]] inline constexpr std::uint64_t multiply_64 ( std::uint64_t const x_, std::uint64_t const y_,
+                                                           std::uint64_t & l_ ) noexcept {
+#if defined( __SIZEOF_INT128__ )
+    __uint128_t const m = static_cast<__uint128_t> ( x_ ) * y_;
+    l_                  = static_cast<std::uint64_t> ( m );
+    return static_cast<std::uint64_t> ( m >> 64 );
+#else
+#    if defined( _MSC_VER ) and not defined( __clang__ ) and defined( _M_X64 ) and _MSC_VER >= 1925
+    if ( not __builtin_is_constant_evaluated ( ) ) {
+        std::uint64_t h = 0u;
+        l_              = _umul128 ( x_, y_, &h );
+        return h;
+    }
+#    endif
+    std::uint64_t const x0 = x_ & 0xFFFF'FFFF, x1 = x_ >> 32, y0 = y_ & 0xFFFF'FFFF, y1 = y_ >> 32;
+    std::uint64_t const p00 = x0 * y0, p01 = x0 * y1, p10 = x1 * y0, p11 = x1 * y1;
+    std::uint64_t const mid = ( p00 >> 32 ) + ( p01 & 0xFFFF'FFFF ) + ( p10 & 0xFFFF'FFFF );
+    l_                      = ( mid << 32 ) | ( p00 & 0xFFFF'FFFF );
+    return p11 + ( p01 >> 32 ) + ( p10 >> 32 ) + ( mid >> 32 );
+#endif
+}
+
+} // namespace detail
+} // namespace sax
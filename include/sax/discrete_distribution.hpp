@@ -0,0 +1,152 @@
+
+// MIT License
+//
+// Copyright (c) 2020 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "uniform_int_distribution.hpp"
+#include "uniform_real_distribution.hpp"
+
+// Discrete distribution with Vose's alias method, O ( n ) construction, O ( 1 ) sampling: one 64-bit word is
+// reduced (Lemire) to a bucket, the low half of the product, uniform given the bucket, is the biased coin deciding between
+// the bucket and its alias. Bucket, coin threshold and alias share one 16-byte entry, a sample touches one cache line.
+// The coin has a resolution of n / 2 ^ 64.
+
+namespace sax {
+
+template<typename IntType = int>
+class discrete_distribution {
+    static_assert ( std::is_integral<IntType>::value, "result_type must be an integral type." );
+
+    public:
+    using result_type = IntType;
+
+    private:
+    struct alignas ( 16 ) entry {
+        std::uint64_t threshold; // The bucket is chosen iff the coin < threshold.
+        std::uint64_t alias;
+    };
+
+    std::vector<entry> table_;
+    std::vector<double> probabilities_;
+
+    void init ( ) {
+        std::size_t const n = probabilities_.size ( );
+        double sum          = 0.0;
+        for ( double w : probabilities_ ) {
+            assert ( w >= 0.0 );
+            sum += w;
+        }
+        assert ( sum > 0.0 );
+        std::vector<double> scaled ( n );
+        std::vector<std::uint64_t> small, large;
+        small.reserve ( n );
+        large.reserve ( n );
+        for ( std::size_t i = 0u; i < n; ++i ) {
+            probabilities_[ i ] /= sum;
+            scaled[ i ] = probabilities_[ i ] * static_cast<double> ( n );
+            ( scaled[ i ] < 1.0 ? small : large ).push_back ( i );
+        }
+        table_.resize ( n );
+        while ( small.size ( ) and large.size ( ) ) {
+            std::uint64_t const s = small.back ( ), l = large.back ( );
+            small.pop_back ( );
+            table_[ s ] = { threshold ( scaled[ s ] ), l };
+            scaled[ l ] = ( scaled[ l ] + scaled[ s ] ) - 1.0;
+            if ( scaled[ l ] < 1.0 ) {
+                large.pop_back ( );
+                small.push_back ( l );
+            }
+        }
+        // What's left is 1, up to rounding.
+        for ( std::uint64_t i : large )
+            table_[ i ] = { std::numeric_limits<std::uint64_t>::max ( ), i };
+        for ( std::uint64_t i : small )
+            table_[ i ] = { std::numeric_limits<std::uint64_t>::max ( ), i };
+    }
+
+    [[nodiscard]] static std::uint64_t threshold ( double p_ ) noexcept {
+        return p_ < 1.0 ? static_cast<std::uint64_t> ( p_ * 0x1.0p64 ) : std::numeric_limits<std::uint64_t>::max ( );
+    }
+
+    template<typename Gen>
+    [[nodiscard]] result_type sample ( Gen & rng_, std::uint64_t w_ ) const {
+        std::uint64_t const n = table_.size ( );
+        std::uint64_t coin, bucket = detail::multiply_64 ( w_, n, coin );
+        if ( coin < n ) {
+            std::uint64_t const rejection = ( 0u - n ) % n;
+            while ( coin < rejection )
+                bucket = detail::multiply_64 ( real_detail::word ( rng_ ), n, coin );
+        }
+        entry const & e = table_[ bucket ];
+        return static_cast<result_type> ( coin < e.threshold ? bucket : e.alias );
+    }
+
+    public:
+    discrete_distribution ( ) : probabilities_ ( 1u, 1.0 ) { init ( ); }
+
+    template<typename InputIt>
+    discrete_distribution ( InputIt first, InputIt last ) : probabilities_ ( first, last ) {
+        if ( probabilities_.empty ( ) )
+            probabilities_.push_back ( 1.0 );
+        init ( );
+    }
+
+    discrete_distribution ( std::initializer_list<double> weights ) :
+        discrete_distribution ( std::begin ( weights ), std::end ( weights ) ) {}
+
+    void reset ( ) const noexcept {}
+
+    [[nodiscard]] std::vector<double> probabilities ( ) const { return probabilities_; }
+
+    [[nodiscard]] result_type min ( ) const noexcept { return result_type ( 0 ); }
+    [[nodiscard]] result_type max ( ) const noexcept { return static_cast<result_type> ( table_.size ( ) - 1u ); }
+
+    template<typename Gen>
+    [[nodiscard]] result_type operator( ) ( Gen & rng ) const {
+        return sample ( rng, real_detail::word ( rng ) );
+    }
+
+    // Fills [ first, last ), the words are drawn in blocks, the same sequence as repeated calls to operator ( ), unless
+    // a bucket index is rejected (with probability < n / 2 ^ 64).
+    template<typename Gen, typename OutputIt>
+    void generate ( Gen & rng, OutputIt first, OutputIt last ) const {
+        real_detail::generate_blocks ( rng, first, last, [ this, &rng ] ( std::uint64_t w ) { return sample ( rng, w ); } );
+    }
+
+    [[nodiscard]] bool operator== ( discrete_distribution const & rhs ) const noexcept {
+        return probabilities_ == rhs.probabilities_;
+    }
+    [[nodiscard]] bool operator!= ( discrete_distribution const & rhs ) const noexcept { return not( *this == rhs ); }
+};
+
+} // namespace sax
@@ -30,7 +30,16 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
 
 namespace sax {
 
@@ -41,13 +50,153 @@ namespace detail {
 
 template<std::intptr_t Size>
 using required_size_type =
-    std::conditional_t<std::numeric_limits<char>::max ( ) <= Size, char,
-                       std::conditional_t<std::numeric_limits<short>::max ( ) <= Size, short,
-                                          std::conditional_t<std::numeric_limits<int>::max ( ) <= Size, int, long long>>>;
+    std::conditional_t<Size <= std::numeric_limits<char>::max ( ), char,
+                       std::conditional_t<Size <= std::numeric_limits<short>::max ( ), short,
+                                          std::conditional_t<Size <= std::numeric_limits<int>::max ( ), int, long long>>>;
 }
 
-// 'disjoint_set' using the path-compression technique and ranking
-template<std::intptr_t PopulationSize, std::intptr_t GroupsSize>
+// Find policies, all iterative.
+namespace find_policy {
+// Full path compression (two passes), every node on the path will point to the root.
+struct path_compression {
+    template<typename Container, typename SizeType>
+    static constexpr SizeType find ( Container & parent_, SizeType x_ ) noexcept {
+        SizeType root = x_;
+        while ( parent_[ root ] != root )
+            root = parent_[ root ];
+        while ( parent_[ x_ ] != root ) {
+            SizeType const next = parent_[ x_ ];
+            parent_[ x_ ]       = root;
+            x_                  = next;
+        }
+        return root;
+    }
+};
+// Path halving (one pass), every other node on the path will point to its grand-parent.
+struct path_halving {
+    template<typename Container, typename SizeType>
+    static constexpr SizeType find ( Container & parent_, SizeType x_ ) noexcept {
+        while ( parent_[ x_ ] != x_ ) {
+            parent_[ x_ ] = parent_[ parent_[ x_ ] ];
+            x_            = parent_[ x_ ];
+        }
+        return x_;
+    }
+};
+// Path splitting (one pass), every node on the path will point to its grand-parent.
+struct path_splitting {
+    template<typename Container, typename SizeType>
+    static constexpr SizeType find ( Container & parent_, SizeType x_ ) noexcept {
+        while ( parent_[ x_ ] != x_ ) {
+            SizeType const next = parent_[ x_ ];
+            parent_[ x_ ]       = parent_[ next ];
+            x_                  = next;
+        }
+        return x_;
+    }
+};
+} // namespace find_policy
+
+// Union policies, link two representatives and return the new representative, the 'rank'-array holds the ranks or the
+// sizes of the groups.
+namespace union_policy {
+struct by_rank {
+    // The rank of a group never exceeds log2 ( population ).
+    template<typename SizeType>
+    using rank_type = std::uint8_t;
+    template<typename SizeType>
+    static constexpr SizeType initial_rank = SizeType{ 0 };
+
+    template<typename Ranks, typename Container, typename SizeType>
+    static constexpr SizeType link ( Ranks & rank_, Container & parent_, SizeType irep_, SizeType jrep_ ) noexcept {
+        switch ( auto irank = rank_[ irep_ ], jrank = rank_[ jrep_ ]; ( irank > jrank ) - ( irank < jrank ) ) {
+            case -1: return parent_[ irep_ ] = jrep_;
+            case +0: rank_[ jrep_ ]++; return parent_[ irep_ ] = jrep_;
+            case +1: [[fallthrough]];
+            default: return parent_[ jrep_ ] = irep_;
+        }
+    }
+};
+struct by_size {
+    template<typename SizeType>
+    using rank_type = SizeType;
+    template<typename SizeType>
+    static constexpr SizeType initial_rank = SizeType{ 1 };
+
+    template<typename Ranks, typename Container, typename SizeType>
+    static constexpr SizeType link ( Ranks & size_, Container & parent_, SizeType irep_, SizeType jrep_ ) noexcept {
+        if ( size_[ irep_ ] < size_[ jrep_ ] ) {
+            size_[ jrep_ ] += size_[ irep_ ];
+            return parent_[ irep_ ] = jrep_;
+        }
+        size_[ irep_ ] += size_[ jrep_ ];
+        return parent_[ jrep_ ] = irep_;
+    }
+};
+} // namespace union_policy
+
+// The groups of a disjoint set in CSR-layout, the members of group g are members[ offsets[ g ] ] up to (but not including)
+// members[ offsets[ g + 1 ] ], groups are ordered by their smallest member, members are in ascending order.
+template<typename SizeType>
+struct disjoint_groups {
+
+    using size_type = SizeType;
+
+    std::vector<size_type> offsets; // group_count ( ) + 1 entries.
+    std::vector<size_type> members;
+
+    [[nodiscard]] std::size_t size ( ) const noexcept { return offsets.size ( ) - 1; }
+    [[nodiscard]] std::size_t size ( std::size_t g_ ) const noexcept {
+        return static_cast<std::size_t> ( offsets[ g_ + 1 ] - offsets[ g_ ] );
+    }
+    [[nodiscard]] size_type const * begin ( std::size_t g_ ) const noexcept { return members.data ( ) + offsets[ g_ ]; }
+    [[nodiscard]] size_type const * end ( std::size_t g_ ) const noexcept { return members.data ( ) + offsets[ g_ + 1 ]; }
+};
+
+namespace detail {
+// Points every element directly to its representative, in one linear pass.
+template<typename FindPolicy, typename Container>
+void flatten ( Container & parent_, std::size_t size_ ) noexcept {
+    using size_type = std::remove_reference_t<decltype ( parent_[ 0 ] )>;
+    for ( std::size_t i = 0; i < size_; ++i )
+        parent_[ i ] = FindPolicy::find ( parent_, static_cast<size_type> ( i ) );
+}
+template<typename Container>
+[[nodiscard]] std::size_t count_roots ( Container const & parent_, std::size_t size_ ) noexcept {
+    std::size_t count = 0;
+    for ( std::size_t i = 0; i < size_; ++i )
+        count += static_cast<std::size_t> ( parent_[ i ] ) == i;
+    return count;
+}
+// Counting sort of the elements over their representatives, the parent-array must be flat.
+template<typename SizeType, typename Container>
+[[nodiscard]] disjoint_groups<SizeType> make_groups ( Container const & parent_, std::size_t size_ ) {
+    disjoint_groups<SizeType> groups;
+    // The group (+ 1) of a representative, the representative of the first element of a group is numbered first.
+    std::vector<SizeType> group ( size_ );
+    std::size_t count = 0;
+    for ( std::size_t i = 0; i < size_; ++i )
+        if ( not group[ static_cast<std::size_t> ( parent_[ i ] ) ] )
+            group[ static_cast<std::size_t> ( parent_[ i ] ) ] = static_cast<SizeType> ( ++count );
+    groups.offsets.assign ( count + 1, SizeType{ 0 } );
+    for ( std::size_t i = 0; i < size_; ++i )
+        ++groups.offsets[ static_cast<std::size_t> ( group[ static_cast<std::size_t> ( parent_[ i ] ) ] ) - 1 ];
+    // offsets[ g ] is now the end of group g, fill the groups back to front, leaving offsets[ g ] at the begin of group g.
+    std::partial_sum ( groups.offsets.begin ( ), groups.offsets.end ( ) - 1, groups.offsets.begin ( ) );
+    groups.members.resize ( size_ );
+    for ( std::size_t i = size_; i-- > 0; )
+        groups.members[ static_cast<std::size_t> (
+            --groups.offsets[ static_cast<std::size_t> ( group[ static_cast<std::size_t> ( parent_[ i ] ) ] ) - 1 ] ) ] =
+            static_cast<SizeType> ( i );
+    groups.offsets.back ( ) = static_cast<SizeType> ( size_ );
+    return groups;
+}
+} // namespace detail
+
+// 'disjoint_set' using the path-compression technique and ranking (by default), the find- and union-strategies are
+// selectable with the FindPolicy and UnionPolicy (see above).
+template<std::intptr_t PopulationSize, std::intptr_t GroupsSize, typename FindPolicy = find_policy::path_compression,
+         typename UnionPolicy = union_policy::by_rank>
 struct disjoint_set {
 
     using size_type = detail::required_size_type<PopulationSize>;
@@ -67,22 +216,22 @@ struct disjoint_set {
         return name[ unite ( x_, y_, group_name_ ) ];
     }
 
-    private:
-    constexpr size_type find_impl ( size_type x_ ) noexcept {
-        if ( parent[ x_ ] == x_ )
-            return x_;
-        return parent[ x_ ] = find_impl ( parent[ x_ ] );
+    // Fully compresses all paths, in O(n).
+    void flatten ( ) noexcept { detail::flatten<FindPolicy> ( parent, PopulationSize ); }
+    [[nodiscard]] std::size_t group_count ( ) const noexcept { return detail::count_roots ( parent, PopulationSize ); }
+    // All groups, in O(n), flattens first.
+    [[nodiscard]] disjoint_groups<size_type> groups ( ) {
+        flatten ( );
+        return detail::make_groups<size_type> ( parent, PopulationSize );
     }
 
+    private:
+    constexpr size_type find_impl ( size_type x_ ) noexcept { return FindPolicy::find ( parent, x_ ); }
+
     // Returns the current group representative.
     [[maybe_unused]] constexpr size_type unite_impl ( size_type x_, size_type y_ ) noexcept {
         if ( size_type irep = find_impl ( x_ ), jrep = find_impl ( y_ ); irep != jrep )
-            switch ( size_type irank = rank[ irep ], jrank = rank[ jrep ]; ( irank > jrank ) - ( irank < jrank ) ) {
-                case -1: return parent[ irep ] = jrep;
-                case +0: rank[ jrep ]++; return parent[ irep ] = jrep;
-                case +1: [[fallthrough]];
-                default: return parent[ jrep ] = irep;
-            }
+            return UnionPolicy::link ( rank, parent, irep, jrep );
         else
             return irep;
     }
@@ -90,7 +239,12 @@ struct disjoint_set {
     using container = std::array<size_type, PopulationSize>;
     using names     = std::array<atom_type, PopulationSize>;
 
-    alignas ( 64 ) container rank   = { };
+    alignas ( 64 ) container rank = [] {
+        container r{ };
+        for ( auto & v : r )
+            v = UnionPolicy::template initial_rank<size_type>;
+        return r;
+    }( );
     alignas ( 64 ) container parent = [] {
         container p;
         auto it = p.begin ( ), end = p.end ( );
@@ -107,4 +261,362 @@ struct disjoint_set {
     }( );
 };
 
+// 'disjoint_set' with its population sized at run-time, on the heap. Single elements can be added with grow ( ). The
+// names are only allocated once a group is named.
+template<typename SizeType, typename FindPolicy = find_policy::path_compression, typename UnionPolicy = union_policy::by_rank>
+struct basic_dynamic_disjoint_set {
+
+    using size_type = SizeType;
+
+    static_assert ( std::is_unsigned<size_type>::value, "size_type should be unsigned" );
+
+    basic_dynamic_disjoint_set ( ) noexcept = default;
+    explicit basic_dynamic_disjoint_set ( std::size_t population_size_ ) { grow ( population_size_ ); }
+
+    // Converting constructor, used when the population outgrows the size_type.
+    template<typename OtherSizeType>
+    explicit basic_dynamic_disjoint_set ( basic_dynamic_disjoint_set<OtherSizeType, FindPolicy, UnionPolicy> const & other_ ) :
+        rank ( other_.rank.begin ( ), other_.rank.end ( ) ), parent ( other_.parent.begin ( ), other_.parent.end ( ) ), name ( other_.name ) {}
+
+    [[nodiscard]] static constexpr std::size_t max_size ( ) noexcept { return std::numeric_limits<size_type>::max ( ); }
+    [[nodiscard]] std::size_t size ( ) const noexcept { return parent.size ( ); }
+
+    void reserve ( std::size_t capacity_ ) {
+        assert ( capacity_ <= max_size ( ) );
+        rank.reserve ( capacity_ );
+        parent.reserve ( capacity_ );
+        if ( name.size ( ) )
+            name.reserve ( capacity_ );
+    }
+    // Adds n_ singletons, returns the index of the first one added.
+    [[maybe_unused]] size_type grow ( std::size_t n_ = 1 ) {
+        std::size_t const first = size ( );
+        assert ( first + n_ <= max_size ( ) );
+        rank.resize ( first + n_, UnionPolicy::template initial_rank<rank_type> );
+        parent.resize ( first + n_ );
+        std::iota ( parent.begin ( ) + first, parent.end ( ), static_cast<size_type> ( first ) );
+        if ( name.size ( ) )
+            name.resize ( first + n_, nullatom );
+        return static_cast<size_type> ( first );
+    }
+
+    size_type find ( size_type x_ ) noexcept { return FindPolicy::find ( parent, x_ ); }
+    atom_type find_name ( size_type x_ ) noexcept { return name.size ( ) ? name[ find ( x_ ) ] : nullatom; }
+
+    // Returns the current group-representative-index, iff an atom is passed, that atom will be set as the groupss name.
+    [[maybe_unused]] size_type unite ( size_type x_, size_type y_, atom_type group_name_ = nullatom ) {
+        size_type group_rep = unite_impl ( x_, y_ );
+        if ( nullatom != group_name_ ) {
+            if ( name.empty ( ) )
+                name.resize ( size ( ), nullatom );
+            name[ group_rep ] = group_name_;
+        }
+        return group_rep;
+    }
+    [[maybe_unused]] atom_type unite_name ( size_type x_, size_type y_, atom_type group_name_ = nullatom ) {
+        size_type const group_rep = unite ( x_, y_, group_name_ );
+        return name.size ( ) ? name[ group_rep ] : nullatom;
+    }
+
+    // Fully compresses all paths, in O(n).
+    void flatten ( ) noexcept { detail::flatten<FindPolicy> ( parent, size ( ) ); }
+    [[nodiscard]] std::size_t group_count ( ) const noexcept { return detail::count_roots ( parent, size ( ) ); }
+    // All groups, in O(n), flattens first.
+    [[nodiscard]] disjoint_groups<size_type> groups ( ) {
+        flatten ( );
+        return detail::make_groups<size_type> ( parent, size ( ) );
+    }
+
+    private:
+    template<typename OtherSizeType, typename, typename>
+    friend struct basic_dynamic_disjoint_set;
+
+    using rank_type = typename UnionPolicy::template rank_type<size_type>;
+
+    [[maybe_unused]] size_type unite_impl ( size_type x_, size_type y_ ) noexcept {
+        if ( size_type irep = find ( x_ ), jrep = find ( y_ ); irep != jrep )
+            return UnionPolicy::link ( rank, parent, irep, jrep );
+        else
+            return irep;
+    }
+
+    std::vector<rank_type> rank;
+    std::vector<size_type> parent;
+    std::vector<atom_type> name;
+};
+
+// 'dynamic_disjoint_set', the index type is chosen at run-time from the population size (and widened when grow ( )
+// requires it), keeping the parent-array as compact as possible.
+template<typename FindPolicy = find_policy::path_compression, typename UnionPolicy = union_policy::by_rank>
+struct dynamic_disjoint_set {
+
+    using size_type = std::size_t;
+
+    dynamic_disjoint_set ( ) noexcept = default;
+    explicit dynamic_disjoint_set ( size_type population_size_ ) : set ( make_set ( population_size_ ) ) {}
+
+    [[nodiscard]] size_type size ( ) const noexcept {
+        return std::visit ( [] ( auto const & s ) -> size_type { return s.size ( ); }, set );
+    }
+
+    void reserve ( size_type capacity_ ) {
+        widen ( capacity_ );
+        std::visit ( [ capacity_ ] ( auto & s ) { s.reserve ( capacity_ ); }, set );
+    }
+    // Adds n_ singletons, returns the index of the first one added.
+    [[maybe_unused]] size_type grow ( size_type n_ = 1 ) {
+        widen ( size ( ) + n_ );
+        return std::visit ( [ n_ ] ( auto & s ) -> size_type { return s.grow ( n_ ); }, set );
+    }
+
+    size_type find ( size_type x_ ) noexcept {
+        return std::visit ( [ x_ ] ( auto & s ) -> size_type { return s.find ( index ( s, x_ ) ); }, set );
+    }
+    atom_type find_name ( size_type x_ ) noexcept {
+        return std::visit ( [ x_ ] ( auto & s ) { return s.find_name ( index ( s, x_ ) ); }, set );
+    }
+
+    [[maybe_unused]] size_type unite ( size_type x_, size_type y_, atom_type group_name_ = nullatom ) {
+        return std::visit ( [ = ] ( auto & s ) -> size_type { return s.unite ( index ( s, x_ ), index ( s, y_ ), group_name_ ); }, set );
+    }
+    [[maybe_unused]] atom_type unite_name ( size_type x_, size_type y_, atom_type group_name_ = nullatom ) {
+        return std::visit ( [ = ] ( auto & s ) { return s.unite_name ( index ( s, x_ ), index ( s, y_ ), group_name_ ); }, set );
+    }
+
+    void flatten ( ) noexcept {
+        std::visit ( [] ( auto & s ) { s.flatten ( ); }, set );
+    }
+    [[nodiscard]] size_type group_count ( ) const noexcept {
+        return std::visit ( [] ( auto const & s ) -> size_type { return s.group_count ( ); }, set );
+    }
+    [[nodiscard]] disjoint_groups<size_type> groups ( ) {
+        return std::visit (
+            [] ( auto & s ) {
+                auto g = s.groups ( );
+                if constexpr ( std::is_same<typename decltype ( g )::size_type, size_type>::value )
+                    return g;
+                else
+                    return disjoint_groups<size_type>{ { g.offsets.begin ( ), g.offsets.end ( ) },
+                                                       { g.members.begin ( ), g.members.end ( ) } };
+            },
+            set );
+    }
+
+    private:
+    template<typename SizeType>
+    using basic_set = basic_dynamic_disjoint_set<SizeType, FindPolicy, UnionPolicy>;
+    using set_type  = std::variant<basic_set<std::uint16_t>, basic_set<std::uint32_t>, basic_set<std::uint64_t>>;
+
+    template<typename Set>
+    static typename Set::size_type index ( Set const &, size_type x_ ) noexcept {
+        assert ( x_ < Set::max_size ( ) );
+        return static_cast<typename Set::size_type> ( x_ );
+    }
+
+    [[nodiscard]] static set_type make_set ( size_type population_size_ ) {
+        if ( population_size_ <= basic_set<std::uint16_t>::max_size ( ) )
+            return basic_set<std::uint16_t> ( population_size_ );
+        if ( population_size_ <= basic_set<std::uint32_t>::max_size ( ) )
+            return basic_set<std::uint32_t> ( population_size_ );
+        return basic_set<std::uint64_t> ( population_size_ );
+    }
+
+    // Converts to a wider index type, iff the current one cannot hold population_size_ elements.
+    void widen ( size_type population_size_ ) {
+        if ( auto * s = std::get_if<0> ( &set ); s and population_size_ > s->max_size ( ) )
+            set = basic_set<std::uint32_t> ( *s );
+        if ( auto * s = std::get_if<1> ( &set ); s and population_size_ > s->max_size ( ) )
+            set = basic_set<std::uint64_t> ( *s );
+    }
+
+    set_type set;
+};
+
+// 'rollback_disjoint_set', union by rank without path compression, every (effective) unite ( ) is recorded, allowing
+// to undo the last k unions in O(k) with rollback ( snapshot ). find ( ) is O(log n). Laid out as structure-of-arrays,
+// the parent-array, which is what find ( ) walks, is kept dense.
+template<typename SizeType = std::uint32_t>
+struct rollback_disjoint_set {
+
+    using size_type     = SizeType;
+    using snapshot_type = std::size_t;
+
+    static_assert ( std::is_unsigned<size_type>::value, "size_type should be unsigned" );
+
+    explicit rollback_disjoint_set ( std::size_t population_size_ ) :
+        rank ( population_size_, std::uint8_t{ 0 } ), parent ( population_size_ ), groups ( population_size_ ) {
+        assert ( population_size_ <= std::numeric_limits<size_type>::max ( ) );
+        std::iota ( parent.begin ( ), parent.end ( ), size_type{ 0 } );
+    }
+
+    [[nodiscard]] std::size_t size ( ) const noexcept { return parent.size ( ); }
+    [[nodiscard]] std::size_t group_count ( ) const noexcept { return groups; }
+
+    [[nodiscard]] size_type find ( size_type x_ ) const noexcept {
+        while ( parent[ x_ ] != x_ )
+            x_ = parent[ x_ ];
+        return x_;
+    }
+    [[nodiscard]] bool same_group ( size_type x_, size_type y_ ) const noexcept { return find ( x_ ) == find ( y_ ); }
+
+    // Returns the current group representative.
+    [[maybe_unused]] size_type unite ( size_type x_, size_type y_ ) {
+        size_type irep = find ( x_ ), jrep = find ( y_ );
+        if ( irep == jrep )
+            return irep;
+        if ( rank[ irep ] > rank[ jrep ] )
+            std::swap ( irep, jrep );
+        bool const bump = rank[ irep ] == rank[ jrep ];
+        rank[ jrep ] += bump;
+        parent[ irep ] = jrep;
+        --groups;
+        history.push_back ( { irep, bump } );
+        return jrep;
+    }
+
+    // The state to return to with rollback ( ).
+    [[nodiscard]] snapshot_type snapshot ( ) const noexcept { return history.size ( ); }
+    // Undoes all unions since snapshot_.
+    void rollback ( snapshot_type snapshot_ ) noexcept {
+        assert ( snapshot_ <= history.size ( ) );
+        while ( history.size ( ) > snapshot_ ) {
+            undo_type const & u = history.back ( );
+            size_type const root = parent[ u.child ];
+            rank[ root ] -= u.rank_bumped;
+            parent[ u.child ] = u.child;
+            ++groups;
+            history.pop_back ( );
+        }
+    }
+
+    private:
+    struct undo_type {
+        size_type child; // The root that was linked under another root.
+        bool rank_bumped;
+    };
+
+    std::vector<std::uint8_t> rank;
+    std::vector<size_type> parent;
+    std::vector<undo_type> history;
+    std::size_t groups;
+};
+
+// 'concurrent_disjoint_set', lock-free union-find (after Anderson-Woll and Jayanti-Tarjan). The parent-array holds
+// atomics, unite ( ) links the roots with a CAS, find ( ) halves the path opportunistically (a failed CAS is simply
+// ignored). Roots are linked by a fixed random order on the indices (a hash of the index, ties broken by index),
+// which keeps the trees shallow in expectation. All member functions, apart from construction, are thread-safe.
+template<typename SizeType = std::uint32_t>
+struct concurrent_disjoint_set {
+
+    using size_type = SizeType;
+
+    static_assert ( std::is_unsigned<size_type>::value, "size_type should be unsigned" );
+
+    explicit concurrent_disjoint_set ( std::size_t population_size_ ) :
+        parent ( std::make_unique<std::atomic<size_type>[]> ( population_size_ ) ), population_size ( population_size_ ) {
+        assert ( population_size_ <= std::numeric_limits<size_type>::max ( ) );
+        for ( std::size_t i = 0; i < population_size_; ++i )
+            parent[ i ].store ( static_cast<size_type> ( i ), std::memory_order_relaxed );
+    }
+
+    [[nodiscard]] std::size_t size ( ) const noexcept { return population_size; }
+
+    [[nodiscard]] size_type find ( size_type x_ ) noexcept {
+        while ( true ) {
+            size_type p = parent[ x_ ].load ( std::memory_order_acquire );
+            if ( p == x_ )
+                return x_;
+            size_type const gp = parent[ p ].load ( std::memory_order_acquire );
+            if ( p != gp )
+                parent[ x_ ].compare_exchange_weak ( p, gp, std::memory_order_release, std::memory_order_relaxed );
+            x_ = gp;
+        }
+    }
+
+    // Returns the representative of the united group.
+    [[maybe_unused]] size_type unite ( size_type x_, size_type y_ ) noexcept {
+        while ( true ) {
+            x_ = find ( x_ );
+            y_ = find ( y_ );
+            if ( x_ == y_ )
+                return x_;
+            if ( precedes ( x_, y_ ) )
+                std::swap ( x_, y_ );
+            // Link y_ (the lower of the two in the order) under x_, fails iff y_ stopped being a root.
+            size_type expected = y_;
+            if ( parent[ y_ ].compare_exchange_strong ( expected, x_, std::memory_order_acq_rel, std::memory_order_relaxed ) )
+                return x_;
+        }
+    }
+
+    [[nodiscard]] bool same_group ( size_type x_, size_type y_ ) noexcept {
+        while ( true ) {
+            x_ = find ( x_ );
+            y_ = find ( y_ );
+            if ( x_ == y_ )
+                return true;
+            // x_ still being a root means the answer was valid at the time we looked at it.
+            if ( parent[ x_ ].load ( std::memory_order_acquire ) == x_ )
+                return false;
+        }
+    }
+
+    private:
+    // The (pseudo-)random link order, murmur's finalizer.
+    [[nodiscard]] static constexpr std::uint64_t priority ( std::uint64_t x_ ) noexcept {
+        x_ ^= x_ >> 33;
+        x_ *= 0xFF51AFD7ED558CCD;
+        x_ ^= x_ >> 33;
+        x_ *= 0xC4CEB9FE1A85EC53;
+        x_ ^= x_ >> 33;
+        return x_;
+    }
+    [[nodiscard]] static constexpr bool precedes ( size_type x_, size_type y_ ) noexcept {
+        std::uint64_t const px = priority ( x_ ), py = priority ( y_ );
+        return px < py or ( px == py and x_ < y_ );
+    }
+
+    std::unique_ptr<std::atomic<size_type>[]> parent;
+    std::size_t population_size;
+};
+
+// Labels each of the n_ vertices with the representative of its connected component, the edges_ (a range of pairs,
+// tuples or aggregates of two vertex indices) are united in parallel on threads_ threads.
+template<typename SizeType = std::uint32_t, typename Edges>
+[[nodiscard]] std::vector<SizeType> parallel_connected_components ( Edges const & edges_, std::size_t n_,
+                                                                    unsigned threads_ = std::thread::hardware_concurrency ( ) ) {
+    concurrent_disjoint_set<SizeType> set ( n_ );
+    std::vector<SizeType> labels ( n_ );
+    threads_ = std::max ( threads_, 1u );
+    auto const parallel_for = [ threads_ ] ( std::size_t size_, auto f_ ) {
+        // Joins the started threads on every way out, if starting a thread throws the pool must not be destroyed with
+        // joinable threads (std::terminate).
+        struct join_guard {
+            std::vector<std::thread> pool;
+            ~join_guard ( ) {
+                for ( auto & thread : pool )
+                    thread.join ( );
+            }
+        } guard;
+        guard.pool.reserve ( threads_ - 1 );
+        std::size_t const chunk = ( size_ + threads_ - 1 ) / threads_;
+        for ( unsigned t = 1; t < threads_; ++t )
+            guard.pool.emplace_back ( f_, std::min ( t * chunk, size_ ), std::min ( ( t + 1 ) * chunk, size_ ) );
+        f_ ( std::size_t{ 0 }, std::min ( chunk, size_ ) );
+    };
+    auto const first = std::begin ( edges_ );
+    parallel_for ( static_cast<std::size_t> ( std::distance ( first, std::end ( edges_ ) ) ),
+                   [ & set, first ] ( std::size_t begin_, std::size_t end_ ) {
+                       for ( auto it = std::next ( first, begin_ ), end = std::next ( first, end_ ); it != end; ++it ) {
+                           auto const & [ u, v ] = *it;
+                           set.unite ( static_cast<SizeType> ( u ), static_cast<SizeType> ( v ) );
+                       }
+                   } );
+    parallel_for ( n_, [ & set, & labels ] ( std::size_t begin_, std::size_t end_ ) {
+        for ( std::size_t i = begin_; i < end_; ++i )
+            labels[ i ] = set.find ( static_cast<SizeType> ( i ) );
+    } );
+    return labels;
+}
+
 } // namespace sax
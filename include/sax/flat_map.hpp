@@ -0,0 +1,466 @@
+
+// MIT License
+//
+// Copyright (c) 2020 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined( _MSC_VER ) and not defined( __clang__ )
+#    include <intrin.h>
+#endif
+#if defined( __SSE2__ ) or defined( _M_X64 ) or defined( __AVX2__ )
+#    include <immintrin.h>
+#endif
+
+#include "integer.hpp"
+
+// Open addressing hash map, linear probing in one contiguous array of slots, with one control byte per slot: 0 if the
+// slot is empty, 0x80 | the top 7 bits of the hash otherwise. A lookup starts at the home slot of the key (the low bits of
+// the hash) and compares the control bytes of a group of 32 (AVX2) or 16 (SSE2) slots at once with those 7 bits, until a
+// group with an empty slot. Erase shifts the rest of the cluster back (Knuth's algorithm R), there are no tombstones and
+// probe lengths don't degrade over time. The capacity is a power of 2, the maximum load factor 3 / 4. Hash values are
+// mixed with sax::hash, so std::hash (the identity for integers) is fine.
+//
+// Elements move on rehash and on erase, insert and erase invalidate references and iterators.
+
+namespace sax {
+
+namespace flat_map_detail {
+
+#if defined( __AVX2__ )
+inline constexpr std::size_t group_width = 32u;
+#elif defined( __SSE2__ ) or defined( _M_X64 )
+inline constexpr std::size_t group_width = 16u;
+#else
+inline constexpr std::size_t group_width = 8u;
+#endif
+
+inline constexpr std::uint8_t empty = 0u;
+
+// The control bytes of a map without slots, never written.
+alignas ( group_width ) inline std::uint8_t empty_group[ group_width ] = { };
+
+// Bit i is set iff control byte i of the group at c_ equals b_.
+[[nodiscard]] inline std::uint32_t match ( std::uint8_t const * c_, std::uint8_t const b_ ) noexcept {
+#if defined( __AVX2__ )
+    __m256i const g = _mm256_loadu_si256 ( reinterpret_cast<__m256i const *> ( c_ ) );
+    return static_cast<std::uint32_t> ( _mm256_movemask_epi8 ( _mm256_cmpeq_epi8 ( g, _mm256_set1_epi8 ( static_cast<char> ( b_ ) ) ) ) );
+#elif defined( __SSE2__ ) or defined( _M_X64 )
+    __m128i const g = _mm_loadu_si128 ( reinterpret_cast<__m128i const *> ( c_ ) );
+    return static_cast<std::uint32_t> ( _mm_movemask_epi8 ( _mm_cmpeq_epi8 ( g, _mm_set1_epi8 ( static_cast<char> ( b_ ) ) ) ) );
+#else
+    std::uint32_t m = 0u;
+    for ( std::size_t i = 0u; i < group_width; ++i )
+        m |= std::uint32_t{ c_[ i ] == b_ } << i;
+    return m;
+#endif
+}
+
+// The index of the lowest set bit, m_ > 0.
+[[nodiscard]] inline std::size_t lowest ( std::uint32_t const m_ ) noexcept {
+#if defined( _MSC_VER ) and not defined( __clang__ )
+    unsigned long i;
+    _BitScanForward ( &i, m_ );
+    return i;
+#else
+    return static_cast<std::size_t> ( __builtin_ctz ( m_ ) );
+#endif
+}
+
+} // namespace flat_map_detail
+
+template<typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class flat_map {
+    public:
+    using key_type        = Key;
+    using mapped_type     = Value;
+    using value_type      = std::pair<Key const, Value>;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher          = Hash;
+    using key_equal       = KeyEqual;
+    using reference       = value_type &;
+    using const_reference = value_type const &;
+
+    private:
+    static constexpr size_type group_width = flat_map_detail::group_width;
+    static constexpr size_type alignment   = std::max ( alignof ( value_type ), group_width );
+    static constexpr size_type npos        = ~size_type{ 0 };
+
+    value_type * slots_     = nullptr;
+    std::uint8_t * control_ = flat_map_detail::empty_group; // capacity_ + group_width bytes, the last group mirrors the first.
+    size_type capacity_ = 0u, mask_ = 0u, size_ = 0u;
+    hasher hasher_;
+    key_equal equal_;
+
+    template<bool IsConst>
+    class iterator_type {
+        friend class flat_map;
+        template<bool>
+        friend class iterator_type;
+
+        using map_pointer = std::conditional_t<IsConst, flat_map const *, flat_map *>;
+
+        map_pointer map_ = nullptr;
+        size_type index_ = 0u;
+
+        iterator_type ( map_pointer m_, size_type i_ ) noexcept : map_ ( m_ ), index_ ( i_ ) {}
+
+        iterator_type & skip_empty ( ) noexcept {
+            while ( index_ < map_->capacity_ and flat_map_detail::empty == map_->control_[ index_ ] )
+                ++index_;
+            return *this;
+        }
+
+        public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = typename flat_map::value_type;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = std::conditional_t<IsConst, value_type const *, value_type *>;
+        using reference         = std::conditional_t<IsConst, value_type const &, value_type &>;
+
+        iterator_type ( ) noexcept = default;
+        template<bool C = IsConst, typename = std::enable_if_t<C>>
+        iterator_type ( iterator_type<false> const & it_ ) noexcept : map_ ( it_.map_ ), index_ ( it_.index_ ) {}
+
+        [[nodiscard]] reference operator* ( ) const noexcept { return map_->slots_[ index_ ]; }
+        [[nodiscard]] pointer operator-> ( ) const noexcept { return map_->slots_ + index_; }
+
+        iterator_type & operator++ ( ) noexcept {
+            ++index_;
+            return skip_empty ( );
+        }
+        iterator_type operator++ ( int ) noexcept {
+            iterator_type it = *this;
+            ++*this;
+            return it;
+        }
+
+        template<bool C>
+        [[nodiscard]] bool operator== ( iterator_type<C> const & rhs ) const noexcept {
+            return index_ == rhs.index_;
+        }
+        template<bool C>
+        [[nodiscard]] bool operator!= ( iterator_type<C> const & rhs ) const noexcept {
+            return index_ != rhs.index_;
+        }
+    };
+
+    public:
+    using iterator       = iterator_type<false>;
+    using const_iterator = iterator_type<true>;
+
+    private:
+    [[nodiscard]] std::uint64_t hash_of ( Key const & key_ ) const {
+        return ::sax::hash ( static_cast<std::uint64_t> ( hasher_ ( key_ ) ) );
+    }
+    [[nodiscard]] static std::uint8_t tag_of ( std::uint64_t const hash_ ) noexcept {
+        return static_cast<std::uint8_t> ( ( hash_ >> 57 ) | 0x80u );
+    }
+
+    // Bytes [ 0, group_width ) are mirrored in [ capacity_, capacity_ + group_width ), so a group can be read at any slot.
+    void set_control ( size_type const i_, std::uint8_t const c_ ) noexcept {
+        control_[ i_ ]                                             = c_;
+        control_[ ( ( i_ - group_width ) & mask_ ) + group_width ] = c_;
+    }
+
+    [[nodiscard]] size_type find_index ( Key const & key_, std::uint64_t const hash_ ) const {
+        std::uint8_t const tag = tag_of ( hash_ );
+        for ( size_type pos = hash_ & mask_;; pos = ( pos + group_width ) & mask_ ) {
+            std::uint8_t const * const group = control_ + pos;
+            for ( std::uint32_t m = flat_map_detail::match ( group, tag ); m; m &= m - 1u ) {
+                size_type const i = ( pos + flat_map_detail::lowest ( m ) ) & mask_;
+                if ( equal_ ( slots_[ i ].first, key_ ) )
+                    return i;
+            }
+            if ( flat_map_detail::match ( group, flat_map_detail::empty ) )
+                return npos;
+        }
+    }
+
+    [[nodiscard]] size_type find_empty ( std::uint64_t const hash_ ) const noexcept {
+        for ( size_type pos = hash_ & mask_;; pos = ( pos + group_width ) & mask_ )
+            if ( std::uint32_t const m = flat_map_detail::match ( control_ + pos, flat_map_detail::empty ) )
+                return ( pos + flat_map_detail::lowest ( m ) ) & mask_;
+    }
+
+    [[nodiscard]] static constexpr size_type max_load ( size_type const n_ ) noexcept { return n_ - n_ / 4u; }
+
+    // Control bytes and slots in one block, the slots first.
+    void allocate ( size_type const n_ ) {
+        size_type const slot_bytes = ( n_ * sizeof ( value_type ) + group_width - 1u ) & ~( group_width - 1u );
+        void * const p             = ::operator new ( slot_bytes + n_ + group_width, std::align_val_t{ alignment } );
+        slots_                     = static_cast<value_type *> ( p );
+        control_                   = static_cast<std::uint8_t *> ( p ) + slot_bytes;
+        capacity_                  = n_;
+        mask_                      = n_ - 1u;
+        std::memset ( control_, flat_map_detail::empty, n_ + group_width );
+    }
+
+    void deallocate ( ) noexcept {
+        if ( capacity_ )
+            ::operator delete ( static_cast<void *> ( slots_ ), std::align_val_t{ alignment } );
+        slots_    = nullptr;
+        control_  = flat_map_detail::empty_group;
+        capacity_ = mask_ = size_ = 0u;
+    }
+
+    void destroy_elements ( ) noexcept {
+        if constexpr ( not std::is_trivially_destructible<value_type>::value ) {
+            for ( size_type i = 0u; i < capacity_; ++i )
+                if ( flat_map_detail::empty != control_[ i ] )
+                    slots_[ i ].~value_type ( );
+        }
+    }
+
+    // Moves the elements to a new array of n_ slots, a power of 2, not smaller than group_width.
+    void rehash_to ( size_type const n_ ) {
+        value_type * const slots     = slots_;
+        std::uint8_t * const control = control_;
+        size_type const old_capacity = capacity_, size = size_;
+        allocate ( n_ );
+        size_ = size;
+        for ( size_type i = 0u; i < old_capacity; ++i ) {
+            if ( flat_map_detail::empty != control[ i ] ) {
+                size_type const j = find_empty ( hash_of ( slots[ i ].first ) );
+                ::new ( static_cast<void *> ( slots_ + j ) ) value_type ( std::move ( slots[ i ] ) );
+                slots[ i ].~value_type ( );
+                set_control ( j, control[ i ] );
+            }
+        }
+        if ( old_capacity )
+            ::operator delete ( static_cast<void *> ( slots ), std::align_val_t{ alignment } );
+    }
+
+    // The smallest valid capacity for n_ elements.
+    [[nodiscard]] static size_type capacity_for ( size_type const n_ ) noexcept {
+        size_type const min = ( 4u * n_ + 2u ) / 3u; // ceil ( 4 n / 3 ).
+        return min > group_width ? next_power_2 ( min - 1u ) : group_width;
+    }
+
+    // Re-hashes the keys of the elements after i_, it's noexcept only if the hasher is.
+    void erase_index ( size_type i_ ) noexcept ( std::is_nothrow_invocable_v<hasher const &, Key const &> ) {
+        slots_[ i_ ].~value_type ( );
+        for ( size_type j = ( i_ + 1u ) & mask_; flat_map_detail::empty != control_[ j ]; j = ( j + 1u ) & mask_ ) {
+            // The element at j can fill the hole at i_, iff i_ is in [ home, j ).
+            size_type const home = hash_of ( slots_[ j ].first ) & mask_;
+            if ( ( ( j - home ) & mask_ ) >= ( ( j - i_ ) & mask_ ) ) {
+                ::new ( static_cast<void *> ( slots_ + i_ ) ) value_type ( std::move ( slots_[ j ] ) );
+                slots_[ j ].~value_type ( );
+                set_control ( i_, control_[ j ] );
+                i_ = j;
+            }
+        }
+        set_control ( i_, flat_map_detail::empty );
+        --size_;
+    }
+
+    template<typename K, typename... Args>
+    std::pair<iterator, bool> emplace_key ( K && key_, Args &&... args_ ) {
+        std::uint64_t const hash = hash_of ( key_ );
+        if ( size_type const i = find_index ( key_, hash ); npos != i )
+            return { iterator ( this, i ), false };
+        if ( size_ == max_load ( capacity_ ) )
+            rehash_to ( capacity_ ? 2u * capacity_ : group_width );
+        size_type const i = find_empty ( hash );
+        ::new ( static_cast<void *> ( slots_ + i ) ) value_type (
+            std::piecewise_construct, std::forward_as_tuple ( std::forward<K> ( key_ ) ), std::forward_as_tuple ( std::forward<Args> ( args_ )... ) );
+        set_control ( i, tag_of ( hash ) );
+        ++size_;
+        return { iterator ( this, i ), true };
+    }
+
+    public:
+    flat_map ( ) = default;
+
+    explicit flat_map ( size_type const n_, hasher const & hash_function_ = hasher ( ), key_equal const & key_eq_ = key_equal ( ) ) :
+        hasher_ ( hash_function_ ), equal_ ( key_eq_ ) {
+        if ( n_ )
+            allocate ( capacity_for ( n_ ) );
+    }
+
+    template<typename InputIt>
+    flat_map ( InputIt first_, InputIt last_, size_type const n_ = 0u ) : flat_map ( n_ ) {
+        insert ( first_, last_ );
+    }
+
+    flat_map ( std::initializer_list<value_type> init_ ) : flat_map ( init_.size ( ) ) { insert ( init_.begin ( ), init_.end ( ) ); }
+
+    flat_map ( flat_map const & other_ ) : hasher_ ( other_.hasher_ ), equal_ ( other_.equal_ ) {
+        if ( other_.size_ ) {
+            allocate ( other_.capacity_ );
+            for ( size_type i = 0u; i < capacity_; ++i ) {
+                if ( flat_map_detail::empty != other_.control_[ i ] ) {
+                    ::new ( static_cast<void *> ( slots_ + i ) ) value_type ( other_.slots_[ i ] );
+                    control_[ i ] = other_.control_[ i ];
+                    ++size_;
+                }
+            }
+            std::memcpy ( control_ + capacity_, control_, group_width );
+        }
+    }
+
+    flat_map ( flat_map && other_ ) noexcept { swap ( other_ ); }
+
+    ~flat_map ( ) noexcept {
+        destroy_elements ( );
+        deallocate ( );
+    }
+
+    flat_map & operator= ( flat_map const & other_ ) {
+        if ( this != &other_ ) {
+            flat_map tmp ( other_ );
+            swap ( tmp );
+        }
+        return *this;
+    }
+
+    flat_map & operator= ( flat_map && other_ ) noexcept {
+        swap ( other_ );
+        return *this;
+    }
+
+    void swap ( flat_map & other_ ) noexcept {
+        using std::swap;
+        swap ( slots_, other_.slots_ );
+        swap ( control_, other_.control_ );
+        swap ( capacity_, other_.capacity_ );
+        swap ( mask_, other_.mask_ );
+        swap ( size_, other_.size_ );
+        swap ( hasher_, other_.hasher_ );
+        swap ( equal_, other_.equal_ );
+    }
+
+    [[nodiscard]] iterator begin ( ) noexcept { return iterator ( this, 0u ).skip_empty ( ); }
+    [[nodiscard]] const_iterator begin ( ) const noexcept { return const_iterator ( this, 0u ).skip_empty ( ); }
+    [[nodiscard]] const_iterator cbegin ( ) const noexcept { return begin ( ); }
+    [[nodiscard]] iterator end ( ) noexcept { return iterator ( this, capacity_ ); }
+    [[nodiscard]] const_iterator end ( ) const noexcept { return const_iterator ( this, capacity_ ); }
+    [[nodiscard]] const_iterator cend ( ) const noexcept { return end ( ); }
+
+    [[nodiscard]] bool empty ( ) const noexcept { return not size_; }
+    [[nodiscard]] size_type size ( ) const noexcept { return size_; }
+    [[nodiscard]] size_type capacity ( ) const noexcept { return capacity_; }
+    [[nodiscard]] float load_factor ( ) const noexcept {
+        return capacity_ ? static_cast<float> ( size_ ) / static_cast<float> ( capacity_ ) : 0.0f;
+    }
+    [[nodiscard]] static constexpr float max_load_factor ( ) noexcept { return 0.75f; }
+
+    [[nodiscard]] hasher hash_function ( ) const { return hasher_; }
+    [[nodiscard]] key_equal key_eq ( ) const { return equal_; }
+
+    void clear ( ) noexcept {
+        destroy_elements ( );
+        if ( capacity_ )
+            std::memset ( control_, flat_map_detail::empty, capacity_ + group_width );
+        size_ = 0u;
+    }
+
+    // Makes room for n_ elements without rehashing.
+    void reserve ( size_type const n_ ) {
+        if ( n_ > max_load ( capacity_ ) )
+            rehash_to ( capacity_for ( n_ ) );
+    }
+
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace ( Key const & key_, Args &&... args_ ) {
+        return emplace_key ( key_, std::forward<Args> ( args_ )... );
+    }
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace ( Key && key_, Args &&... args_ ) {
+        return emplace_key ( std::move ( key_ ), std::forward<Args> ( args_ )... );
+    }
+
+    std::pair<iterator, bool> insert ( value_type const & value_ ) { return emplace_key ( value_.first, value_.second ); }
+    std::pair<iterator, bool> insert ( value_type && value_ ) {
+        return emplace_key ( value_.first, std::move ( value_.second ) );
+    }
+    template<typename InputIt>
+    void insert ( InputIt first_, InputIt last_ ) {
+        for ( ; first_ != last_; ++first_ )
+            insert ( *first_ );
+    }
+
+    template<typename V>
+    std::pair<iterator, bool> insert_or_assign ( Key const & key_, V && value_ ) {
+        auto r = emplace_key ( key_, std::forward<V> ( value_ ) );
+        if ( not r.second )
+            r.first->second = std::forward<V> ( value_ );
+        return r;
+    }
+
+    Value & operator[] ( Key const & key_ ) { return emplace_key ( key_ ).first->second; }
+    Value & operator[] ( Key && key_ ) { return emplace_key ( std::move ( key_ ) ).first->second; }
+
+    [[nodiscard]] iterator find ( Key const & key_ ) {
+        size_type const i = find_index ( key_, hash_of ( key_ ) );
+        return iterator ( this, npos == i ? capacity_ : i );
+    }
+    [[nodiscard]] const_iterator find ( Key const & key_ ) const {
+        size_type const i = find_index ( key_, hash_of ( key_ ) );
+        return const_iterator ( this, npos == i ? capacity_ : i );
+    }
+    [[nodiscard]] bool contains ( Key const & key_ ) const { return npos != find_index ( key_, hash_of ( key_ ) ); }
+    [[nodiscard]] size_type count ( Key const & key_ ) const { return contains ( key_ ); }
+
+    size_type erase ( Key const & key_ ) {
+        size_type const i = find_index ( key_, hash_of ( key_ ) );
+        if ( npos == i )
+            return 0u;
+        erase_index ( i );
+        return 1u;
+    }
+    // Elements after it_ may move into its slot (or before it, across the end of the array), don't erase while iterating.
+    void erase ( const_iterator it_ ) { erase_index ( it_.index_ ); }
+
+    [[nodiscard]] bool operator== ( flat_map const & rhs_ ) const {
+        if ( size_ != rhs_.size_ )
+            return false;
+        for ( value_type const & v : *this ) {
+            const_iterator const it = rhs_.find ( v.first );
+            if ( rhs_.end ( ) == it or not( it->second == v.second ) )
+                return false;
+        }
+        return true;
+    }
+    [[nodiscard]] bool operator!= ( flat_map const & rhs_ ) const { return not( *this == rhs_ ); }
+};
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+void swap ( flat_map<Key, Value, Hash, KeyEqual> & lhs_, flat_map<Key, Value, Hash, KeyEqual> & rhs_ ) noexcept {
+    lhs_.swap ( rhs_ );
+}
+
+} // namespace sax
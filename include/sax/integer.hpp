@@ -28,14 +28,24 @@
 #endif
 
 #include <cassert>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
 
 #include <limits>
 #include <string>
+#include <string_view>
 #include <type_traits>
 
+#include "detail/multiply.hpp"
+
+#if defined( __AVX2__ ) or ( defined( __GNUC__ ) and ( defined( __x86_64__ ) or defined( __i386__ ) ) )
+#    include <immintrin.h>
+#endif
+
 namespace sax {
 
 namespace detail {
@@ -73,6 +83,189 @@ constexpr bool are_coprime ( T const a_, T const b_ ) noexcept {
     return gcd<T> ( a_, b_ ) == T ( 1 );
 }
 
+// Division by a run-time constant, Lemire's fastmod (Lemire, Kaser, Kurz, "Faster Remainder by Direct Computation",
+// 2019): with M = ceil ( 2 ^ 2N / d ) (N the width of T), a / d is the high N bits of M * a and a % d is the high N bits
+// of ( M * a mod 2 ^ 2N ) * d, two multiplications instead of a div. For N = 64, M is 128 bits wide, a division costs
+// three 64-bit multiplications. The bulk versions are vectorized (AVX2) for 32 bits.
+template<typename T>
+class fast_divider {
+    static_assert ( std::is_same<T, std::uint32_t>::value or std::is_same<T, std::uint64_t>::value,
+                    "only std::uint32_t and std::uint64_t divisors are allowed." );
+
+    // The M of d = 1 is 2 ^ 2N, which wraps to 0, the mod and is_divisible are still right, div ( ) adds a & one_.
+    std::uint64_t m_hi_ = 0u, m_lo_ = 0u; // For T = std::uint32_t, M is m_lo_.
+    T d_, one_;
+
+    // ( m_hi_, m_lo_ ) * a mod 2 ^ 128.
+    [[nodiscard]] constexpr std::uint64_t low_bits ( std::uint64_t const a_, std::uint64_t & lo_ ) const noexcept {
+        return detail::multiply_64 ( m_lo_, a_, lo_ ) + m_hi_ * a_;
+    }
+
+    public:
+    using value_type = T;
+
+    explicit constexpr fast_divider ( T const divisor_ ) noexcept :
+        d_ ( divisor_ ), one_ ( T ( 1 ) == divisor_ ? ~T ( 0 ) : T ( 0 ) ) {
+        assert ( divisor_ );
+        if constexpr ( std::is_same<T, std::uint32_t>::value ) {
+            m_lo_ = ~std::uint64_t{ 0 } / d_ + 1u;
+        }
+        else {
+            // ( 2 ^ 128 - 1 ) / d_ + 1, by long division of the low word.
+            m_hi_           = ~std::uint64_t{ 0 } / d_;
+            std::uint64_t r = ~std::uint64_t{ 0 } % d_;
+            for ( int i = 0; i < 64; ++i ) {
+                bool const carry = r >> 63;
+                r                = ( r << 1 ) | 1u;
+                m_lo_ <<= 1;
+                if ( carry or r >= d_ ) {
+                    r -= d_;
+                    m_lo_ |= 1u;
+                }
+            }
+            m_hi_ += not( ++m_lo_ );
+        }
+    }
+
+    [[nodiscard]] constexpr T divisor ( ) const noexcept { return d_; }
+
+    [[nodiscard]] constexpr T div ( T const a_ ) const noexcept {
+        std::uint64_t l;
+        if constexpr ( std::is_same<T, std::uint32_t>::value ) {
+            return static_cast<T> ( detail::multiply_64 ( m_lo_, a_, l ) ) | ( a_ & one_ );
+        }
+        else {
+            std::uint64_t const c = detail::multiply_64 ( m_lo_, a_, l );
+            std::uint64_t h       = detail::multiply_64 ( m_hi_, a_, l );
+            h += ( l += c ) < c;
+            return h | ( a_ & one_ );
+        }
+    }
+
+    [[nodiscard]] constexpr T mod ( T const a_ ) const noexcept {
+        std::uint64_t l;
+        if constexpr ( std::is_same<T, std::uint32_t>::value ) {
+            return static_cast<T> ( detail::multiply_64 ( m_lo_ * a_, d_, l ) );
+        }
+        else {
+            std::uint64_t lo;
+            std::uint64_t const hi = low_bits ( a_, lo );
+            std::uint64_t const c  = detail::multiply_64 ( lo, d_, l );
+            std::uint64_t h        = detail::multiply_64 ( hi, d_, l );
+            return h + ( ( l += c ) < c );
+        }
+    }
+
+    // a_ % d_ == 0, M * a mod 2 ^ 2N < M.
+    [[nodiscard]] constexpr bool is_divisible ( T const a_ ) const noexcept {
+        if constexpr ( std::is_same<T, std::uint32_t>::value ) {
+            return m_lo_ * a_ <= m_lo_ - 1u;
+        }
+        else {
+            std::uint64_t lo;
+            std::uint64_t const hi = low_bits ( a_, lo ), m_hi = m_hi_ - not m_lo_, m_lo = m_lo_ - 1u;
+            return hi < m_hi or ( hi == m_hi and lo <= m_lo );
+        }
+    }
+
+    // out_[ i ] = in_[ i ] / d, in_ and out_ may be the same.
+    void div ( T const * in_, T * out_, std::size_t n_ ) const noexcept {
+        std::size_t i = 0u;
+#if defined( __AVX2__ )
+        if constexpr ( std::is_same<T, std::uint32_t>::value )
+            i = div_avx2 ( in_, out_, n_ );
+#endif
+        for ( ; i < n_; ++i )
+            out_[ i ] = div ( in_[ i ] );
+    }
+
+    // out_[ i ] = in_[ i ] % d, in_ and out_ may be the same.
+    void mod ( T const * in_, T * out_, std::size_t n_ ) const noexcept {
+        std::size_t i = 0u;
+#if defined( __AVX2__ )
+        if constexpr ( std::is_same<T, std::uint32_t>::value )
+            i = mod_avx2 ( in_, out_, n_ );
+#endif
+        for ( ; i < n_; ++i )
+            out_[ i ] = mod ( in_[ i ] );
+    }
+
+    // The number of in_[ i ] divisible by d.
+    [[nodiscard]] std::size_t count_divisible ( T const * in_, std::size_t n_ ) const noexcept {
+        std::size_t c = 0u, i = 0u;
+        // With AVX-512 DQ and VL the compiler vectorizes the loop below with vpmullq, which is faster.
+#if defined( __AVX2__ ) and not( defined( __AVX512DQ__ ) and defined( __AVX512VL__ ) )
+        if constexpr ( std::is_same<T, std::uint32_t>::value )
+            i = count_divisible_avx2 ( in_, n_, c );
+#endif
+        for ( ; i < n_; ++i )
+            c += is_divisible ( in_[ i ] );
+        return c;
+    }
+
+    private:
+#if defined( __AVX2__ )
+    // 8 values at a time, the 64-bit products from 32 x 32-bit multiplications of the even and the odd lanes, returns the
+    // number of values done.
+    std::size_t div_avx2 ( std::uint32_t const * in_, std::uint32_t * out_, std::size_t n_ ) const noexcept {
+        __m256i const m_lo = _mm256_set1_epi64x ( m_lo_ & 0xFFFF'FFFF ), m_hi = _mm256_set1_epi64x ( m_lo_ >> 32 );
+        __m256i const one = _mm256_set1_epi32 ( static_cast<int> ( one_ ) );
+        auto const lanes  = [ m_lo, m_hi ] ( __m256i a ) noexcept { // ( M * a ) >> 64 in the low halves.
+            __m256i const c = _mm256_srli_epi64 ( _mm256_mul_epu32 ( m_lo, a ), 32 );
+            return _mm256_srli_epi64 ( _mm256_add_epi64 ( _mm256_mul_epu32 ( m_hi, a ), c ), 32 );
+        };
+        std::size_t i = 0u;
+        for ( ; i + 8u <= n_; i += 8u ) {
+            __m256i const a = _mm256_loadu_si256 ( reinterpret_cast<__m256i const *> ( in_ + i ) );
+            __m256i const q = _mm256_blend_epi32 ( lanes ( a ), _mm256_slli_epi64 ( lanes ( _mm256_srli_epi64 ( a, 32 ) ), 32 ),
+                                                   0b1010'1010 );
+            _mm256_storeu_si256 ( reinterpret_cast<__m256i *> ( out_ + i ), _mm256_or_si256 ( q, _mm256_and_si256 ( a, one ) ) );
+        }
+        return i;
+    }
+
+    std::size_t mod_avx2 ( std::uint32_t const * in_, std::uint32_t * out_, std::size_t n_ ) const noexcept {
+        __m256i const m_lo = _mm256_set1_epi64x ( m_lo_ & 0xFFFF'FFFF ), m_hi = _mm256_set1_epi64x ( m_lo_ >> 32 );
+        __m256i const d    = _mm256_set1_epi64x ( d_ );
+        auto const lanes   = [ m_lo, m_hi, d ] ( __m256i a ) noexcept { // ( ( M * a mod 2 ^ 64 ) * d ) >> 64 in the low halves.
+            __m256i const l = _mm256_add_epi64 ( _mm256_mul_epu32 ( m_lo, a ), _mm256_slli_epi64 ( _mm256_mul_epu32 ( m_hi, a ), 32 ) );
+            __m256i const c = _mm256_srli_epi64 ( _mm256_mul_epu32 ( l, d ), 32 );
+            return _mm256_srli_epi64 ( _mm256_add_epi64 ( _mm256_mul_epu32 ( _mm256_srli_epi64 ( l, 32 ), d ), c ), 32 );
+        };
+        std::size_t i = 0u;
+        for ( ; i + 8u <= n_; i += 8u ) {
+            __m256i const a = _mm256_loadu_si256 ( reinterpret_cast<__m256i const *> ( in_ + i ) );
+            __m256i const r = _mm256_blend_epi32 ( lanes ( a ), _mm256_slli_epi64 ( lanes ( _mm256_srli_epi64 ( a, 32 ) ), 32 ),
+                                                   0b1010'1010 );
+            _mm256_storeu_si256 ( reinterpret_cast<__m256i *> ( out_ + i ), r );
+        }
+        return i;
+    }
+
+    // M * a mod 2 ^ 64 <= M - 1, compared unsigned (by flipping the sign bits), c_ is incremented by the number of
+    // divisible values.
+    std::size_t count_divisible_avx2 ( std::uint32_t const * in_, std::size_t n_, std::size_t & c_ ) const noexcept {
+        __m256i const m_lo = _mm256_set1_epi64x ( m_lo_ & 0xFFFF'FFFF ), m_hi = _mm256_set1_epi64x ( m_lo_ >> 32 );
+        __m256i const sign  = _mm256_set1_epi64x ( std::numeric_limits<std::int64_t>::min ( ) );
+        __m256i const bound = _mm256_xor_si256 ( _mm256_set1_epi64x ( m_lo_ - 1u ), sign );
+        auto const lanes    = [ m_lo, m_hi, sign, bound ] ( __m256i a ) noexcept { // All ones if not divisible.
+            __m256i const l = _mm256_add_epi64 ( _mm256_mul_epu32 ( m_lo, a ), _mm256_slli_epi64 ( _mm256_mul_epu32 ( m_hi, a ), 32 ) );
+            return _mm256_cmpgt_epi64 ( _mm256_xor_si256 ( l, sign ), bound );
+        };
+        __m256i rest  = _mm256_setzero_si256 ( ); // Minus the number of values not divisible.
+        std::size_t i = 0u;
+        for ( ; i + 8u <= n_; i += 8u ) {
+            __m256i const a = _mm256_loadu_si256 ( reinterpret_cast<__m256i const *> ( in_ + i ) );
+            rest = _mm256_add_epi64 ( rest, _mm256_add_epi64 ( lanes ( a ), lanes ( _mm256_srli_epi64 ( a, 32 ) ) ) );
+        }
+        alignas ( 32 ) std::int64_t r[ 4 ];
+        _mm256_store_si256 ( reinterpret_cast<__m256i *> ( r ), rest );
+        c_ += i - static_cast<std::size_t> ( -( r[ 0 ] + r[ 1 ] + r[ 2 ] + r[ 3 ] ) );
+        return i;
+    }
+#endif
+};
+
 // Integer LogN.
 template<int Base, typename T, typename sfinae = std::enable_if_t<std::conjunction_v<std::is_integral<T>, std::is_unsigned<T>>>>
 constexpr T iLog ( T const n_, T const p_ = T ( 0 ) ) noexcept {
@@ -89,14 +282,15 @@ template<typename T, typename = std::enable_if_t<std::conjunction_v<std::is_inte
 constexpr T prev_power_2 ( T value_ ) noexcept {
     value_ |= ( value_ >> 1 );
     value_ |= ( value_ >> 2 );
+    value_ |= ( value_ >> 4 );
     if constexpr ( sizeof ( T ) > 1 ) {
-        value_ |= ( value_ >> 4 );
+        value_ |= ( value_ >> 8 );
     }
     if constexpr ( sizeof ( T ) > 2 ) {
-        value_ |= ( value_ >> 8 );
+        value_ |= ( value_ >> 16 );
     }
     if constexpr ( sizeof ( T ) > 4 ) {
-        value_ |= ( value_ >> 16 );
+        value_ |= ( value_ >> 32 );
     }
     return value_;
 }
@@ -161,6 +355,20 @@ inline constexpr std::uint64_t gray2dec ( std::uint64_t gray_ ) noexcept {
     return gray_;
 }
 
+// Bulk Gray coding, out_[ i ] = dec2gray ( in_[ i ] ) (gray2dec ( in_[ i ] )), in_ and out_ may be the same. Plain
+// loops, only shifts and xors, the compiler vectorizes them for the target.
+template<typename T, typename = std::enable_if_t<std::conjunction_v<std::is_integral<T>, std::is_unsigned<T>>>>
+void dec2gray_bulk ( T const * in_, T * out_, std::size_t const n_ ) noexcept {
+    for ( std::size_t i = 0u; i < n_; ++i )
+        out_[ i ] = dec2gray ( in_[ i ] );
+}
+
+template<typename T, typename = std::enable_if_t<std::conjunction_v<std::is_integral<T>, std::is_unsigned<T>>>>
+void gray2dec_bulk ( T const * in_, T * out_, std::size_t const n_ ) noexcept {
+    for ( std::size_t i = 0u; i < n_; ++i )
+        out_[ i ] = gray2dec ( in_[ i ] );
+}
+
 // FNV1a c++11 constexpr compile time hash functions, 32 and 64 bit
 // str should be a null terminated string literal, value_ should be left out
 // e.g hash_32_fnv1a_const("example")
@@ -176,12 +384,12 @@ inline constexpr std::uint64_t hash_64_fnv1a_const ( char const * const str,
                                 : hash_64_fnv1a_const ( &str[ 1 ], ( value_ ^ std::uint64_t ( str[ 0 ] ) ) * 0x100000001b3 );
 }
 
-inline constexpr std::uint32_t hash_32_fnv1a_const ( std::string const & str_, std::uint32_t const value_ = 0x811c9dc5 ) noexcept {
+// Not constexpr, std::string::c_str ( ) isn't (before c++20), for long strings at run-time, see hash_bytes ( ).
+inline std::uint32_t hash_32_fnv1a_const ( std::string const & str_, std::uint32_t const value_ = 0x811c9dc5 ) noexcept {
     return hash_32_fnv1a_const ( str_.c_str ( ), value_ );
 }
 
-inline constexpr std::uint64_t hash_64_fnv1a_const ( std::string const & str_,
-                                                     std::uint64_t const value_ = 0xcbf29ce484222325 ) noexcept {
+inline std::uint64_t hash_64_fnv1a_const ( std::string const & str_, std::uint64_t const value_ = 0xcbf29ce484222325 ) noexcept {
     return hash_64_fnv1a_const ( str_.c_str ( ), value_ );
 }
 
@@ -255,14 +463,316 @@ inline constexpr std::uint64_t fmix64 ( std::uint64_t key_ ) noexcept {
     return key_;
 }
 
+namespace integer_detail {
+// Little-endian loads, assembled from bytes, which is constexpr, gcc and clang turn them into plain loads.
+[[nodiscard]] inline constexpr std::uint64_t read_byte ( char const * const p_, int const i_ ) noexcept {
+    return std::uint64_t{ static_cast<unsigned char> ( p_[ i_ ] ) } << ( 8 * i_ );
+}
+[[nodiscard]] inline constexpr std::uint64_t read_32 ( char const * const p_ ) noexcept {
+    return read_byte ( p_, 0 ) | read_byte ( p_, 1 ) | read_byte ( p_, 2 ) | read_byte ( p_, 3 );
+}
+[[nodiscard]] inline constexpr std::uint64_t read_64 ( char const * const p_ ) noexcept {
+    return read_byte ( p_, 0 ) | read_byte ( p_, 1 ) | read_byte ( p_, 2 ) | read_byte ( p_, 3 ) | read_byte ( p_, 4 ) |
+           read_byte ( p_, 5 ) | read_byte ( p_, 6 ) | read_byte ( p_, 7 );
+}
+
+// The high and low halves of the product xor-ed.
+[[nodiscard]] inline constexpr std::uint64_t mix ( std::uint64_t const x_, std::uint64_t const y_ ) noexcept {
+    std::uint64_t l  = 0u;
+    std::uint64_t const h = detail::multiply_64 ( x_, y_, l );
+    return h ^ l;
+}
+
+inline constexpr std::uint64_t hash_keys[ 4 ] = { 0xA076'1D64'78BD'642F, 0xE703'7ED1'A0B4'28DB, 0x8EBC'6AF0'9C88'C6E3,
+                                                  0x5899'65CC'7537'4CC3 };
+} // namespace integer_detail
+
+// Hashes len_ bytes at p_, 48 bytes (3 independent multiply-mix lanes) per step, wyhash's structure, with fmix64 seeding.
+// Constexpr, the result doesn't depend on endianness, so compile-time and run-time hashes (on any platform) are the same.
+[[nodiscard]] inline constexpr std::uint64_t hash_bytes ( char const * p_, std::size_t const len_,
+                                                          std::uint64_t seed_ = 0u ) noexcept {
+    using namespace integer_detail;
+    seed_           = fmix64 ( seed_ ^ hash_keys[ 0 ] );
+    std::uint64_t a = 0u, b = 0u;
+    if ( len_ <= 16u ) {
+        if ( len_ >= 8u ) { // Two, possibly overlapping, reads from both ends.
+            a = read_64 ( p_ );
+            b = read_64 ( p_ + len_ - 8u );
+        }
+        else if ( len_ >= 4u ) {
+            a = read_32 ( p_ );
+            b = read_32 ( p_ + len_ - 4u );
+        }
+        else if ( len_ ) {
+            a = ( std::uint64_t{ static_cast<unsigned char> ( p_[ 0 ] ) } << 16 ) |
+                ( std::uint64_t{ static_cast<unsigned char> ( p_[ len_ >> 1 ] ) } << 8 ) | static_cast<unsigned char> ( p_[ len_ - 1u ] );
+        }
+    }
+    else {
+        std::size_t i = len_;
+        if ( i > 48u ) {
+            std::uint64_t s1 = seed_, s2 = seed_;
+            do {
+                seed_ = mix ( read_64 ( p_ ) ^ hash_keys[ 1 ], read_64 ( p_ + 8 ) ^ seed_ );
+                s1    = mix ( read_64 ( p_ + 16 ) ^ hash_keys[ 2 ], read_64 ( p_ + 24 ) ^ s1 );
+                s2    = mix ( read_64 ( p_ + 32 ) ^ hash_keys[ 3 ], read_64 ( p_ + 40 ) ^ s2 );
+                p_ += 48;
+                i -= 48u;
+            } while ( i > 48u );
+            seed_ ^= s1 ^ s2;
+        }
+        for ( ; i > 16u; i -= 16u, p_ += 16 )
+            seed_ = mix ( read_64 ( p_ ) ^ hash_keys[ 1 ], read_64 ( p_ + 8 ) ^ seed_ );
+        a = read_64 ( p_ + i - 16 ); // The last 16 bytes, possibly overlapping.
+        b = read_64 ( p_ + i - 8 );
+    }
+    b = detail::multiply_64 ( a ^ hash_keys[ 1 ], b ^ seed_, a );
+    return mix ( a ^ hash_keys[ 0 ] ^ len_, b ^ hash_keys[ 1 ] );
+}
+
+[[nodiscard]] inline std::uint64_t hash_bytes ( void const * const p_, std::size_t const len_, std::uint64_t const seed_ = 0u ) noexcept {
+    return hash_bytes ( static_cast<char const *> ( p_ ), len_, seed_ );
+}
+
+[[nodiscard]] inline constexpr std::uint64_t hash_bytes ( std::string_view const str_, std::uint64_t const seed_ = 0u ) noexcept {
+    return hash_bytes ( str_.data ( ), str_.size ( ), seed_ );
+}
+
+namespace integer_detail {
+#if defined( __AVX2__ )
+// The 32- or 64-bit lanes of x_, shifted right, and multiplied (the low halves of the products), AVX2 has no 64-bit
+// multiply, a * b = a_lo * b_lo + ( ( a_hi * b_lo + a_lo * b_hi ) << 32 ).
+template<typename T>
+[[nodiscard]] inline __m256i srli ( __m256i const x_, int const s_ ) noexcept {
+    if constexpr ( sizeof ( T ) == 4u )
+        return _mm256_srli_epi32 ( x_, s_ );
+    else
+        return _mm256_srli_epi64 ( x_, s_ );
+}
+template<typename T>
+[[nodiscard]] inline __m256i mullo ( __m256i const x_, __m256i const y_ ) noexcept {
+    if constexpr ( sizeof ( T ) == 4u ) {
+        return _mm256_mullo_epi32 ( x_, y_ );
+    }
+    else {
+#    if defined( __AVX512DQ__ ) and defined( __AVX512VL__ )
+        return _mm256_mullo_epi64 ( x_, y_ );
+#    else
+        __m256i const cross =
+            _mm256_add_epi64 ( _mm256_mul_epu32 ( _mm256_srli_epi64 ( x_, 32 ), y_ ), _mm256_mul_epu32 ( x_, _mm256_srli_epi64 ( y_, 32 ) ) );
+        return _mm256_add_epi64 ( _mm256_mul_epu32 ( x_, y_ ), _mm256_slli_epi64 ( cross, 32 ) );
+#    endif
+    }
+}
+#endif
+#if defined( __AVX512F__ )
+template<typename T>
+[[nodiscard]] inline __m512i srli ( __m512i const x_, unsigned int const s_ ) noexcept {
+    if constexpr ( sizeof ( T ) == 4u )
+        return _mm512_srli_epi32 ( x_, s_ );
+    else
+        return _mm512_srli_epi64 ( x_, s_ );
+}
+template<typename T>
+[[nodiscard]] inline __m512i mullo ( __m512i const x_, __m512i const y_ ) noexcept {
+    if constexpr ( sizeof ( T ) == 4u ) {
+        return _mm512_mullo_epi32 ( x_, y_ );
+    }
+    else {
+#    if defined( __AVX512DQ__ )
+        return _mm512_mullo_epi64 ( x_, y_ );
+#    else
+        __m512i const cross =
+            _mm512_add_epi64 ( _mm512_mul_epu32 ( _mm512_srli_epi64 ( x_, 32 ), y_ ), _mm512_mul_epu32 ( x_, _mm512_srli_epi64 ( y_, 32 ) ) );
+        return _mm512_add_epi64 ( _mm512_mul_epu32 ( x_, y_ ), _mm512_slli_epi64 ( cross, 32 ) );
+#    endif
+    }
+}
+#endif
+
+// out_[ i ] = scalar_ ( in_[ i ] ), with scalar_ ( x ) xor-shifting x right by S, multiplying by C1, xor-shifting,
+// multiplying by C2 and xor-shifting, as hash ( ), unhash ( ) and fmix64 ( ) do, 16 (AVX-512) or 8 (AVX2) 32-bit, or
+// 8 or 4 64-bit, lanes at a time, scalar_ does the tail.
+template<typename T, int S, T C1, T C2>
+void xorshift_multiply_bulk ( T const * in_, T * out_, std::size_t const n_, T ( *scalar_ ) ( T ) ) noexcept {
+    std::size_t i = 0u;
+#if defined( __AVX512F__ )
+    {
+        constexpr std::size_t lanes = sizeof ( __m512i ) / sizeof ( T );
+        __m512i const c1 = sizeof ( T ) == 4u ? _mm512_set1_epi32 ( static_cast<int> ( C1 ) ) : _mm512_set1_epi64 ( static_cast<long long> ( C1 ) );
+        __m512i const c2 = sizeof ( T ) == 4u ? _mm512_set1_epi32 ( static_cast<int> ( C2 ) ) : _mm512_set1_epi64 ( static_cast<long long> ( C2 ) );
+        for ( ; i + lanes <= n_; i += lanes ) {
+            __m512i x = _mm512_loadu_si512 ( in_ + i );
+            x         = mullo<T> ( _mm512_xor_si512 ( x, srli<T> ( x, S ) ), c1 );
+            x         = mullo<T> ( _mm512_xor_si512 ( x, srli<T> ( x, S ) ), c2 );
+            _mm512_storeu_si512 ( out_ + i, _mm512_xor_si512 ( x, srli<T> ( x, S ) ) );
+        }
+    }
+#endif
+#if defined( __AVX2__ )
+    {
+        constexpr std::size_t lanes = sizeof ( __m256i ) / sizeof ( T );
+        __m256i const c1 = sizeof ( T ) == 4u ? _mm256_set1_epi32 ( static_cast<int> ( C1 ) ) : _mm256_set1_epi64x ( static_cast<long long> ( C1 ) );
+        __m256i const c2 = sizeof ( T ) == 4u ? _mm256_set1_epi32 ( static_cast<int> ( C2 ) ) : _mm256_set1_epi64x ( static_cast<long long> ( C2 ) );
+        for ( ; i + lanes <= n_; i += lanes ) {
+            __m256i x = _mm256_loadu_si256 ( reinterpret_cast<__m256i const *> ( in_ + i ) );
+            x         = mullo<T> ( _mm256_xor_si256 ( x, srli<T> ( x, S ) ), c1 );
+            x         = mullo<T> ( _mm256_xor_si256 ( x, srli<T> ( x, S ) ), c2 );
+            _mm256_storeu_si256 ( reinterpret_cast<__m256i *> ( out_ + i ), _mm256_xor_si256 ( x, srli<T> ( x, S ) ) );
+        }
+    }
+#endif
+    for ( ; i < n_; ++i )
+        out_[ i ] = scalar_ ( in_[ i ] );
+}
+} // namespace integer_detail
+
+// Bulk hash ( ), unhash ( ) and fmix64 ( ), out_[ i ] = f ( in_[ i ] ), bit-identical to the scalar functions, in_ and
+// out_ may be the same.
+inline void hash_bulk ( std::uint32_t const * in_, std::uint32_t * out_, std::size_t const n_ ) noexcept {
+    integer_detail::xorshift_multiply_bulk<std::uint32_t, 16, 0X45D9F3B, 0X45D9F3B> ( in_, out_, n_, hash );
+}
+inline void unhash_bulk ( std::uint32_t const * in_, std::uint32_t * out_, std::size_t const n_ ) noexcept {
+    integer_detail::xorshift_multiply_bulk<std::uint32_t, 16, 0X119DE1F3, 0X119DE1F3> ( in_, out_, n_, unhash );
+}
+inline void hash_bulk ( std::uint64_t const * in_, std::uint64_t * out_, std::size_t const n_ ) noexcept {
+    integer_detail::xorshift_multiply_bulk<std::uint64_t, 32, 0xD6E8FEB86659FD93, 0xD6E8FEB86659FD93> ( in_, out_, n_, hash );
+}
+inline void unhash_bulk ( std::uint64_t const * in_, std::uint64_t * out_, std::size_t const n_ ) noexcept {
+    integer_detail::xorshift_multiply_bulk<std::uint64_t, 32, 0xCFEE444D8B59A89B, 0xCFEE444D8B59A89B> ( in_, out_, n_, unhash );
+}
+inline void fmix64_bulk ( std::uint64_t const * in_, std::uint64_t * out_, std::size_t const n_ ) noexcept {
+    integer_detail::xorshift_multiply_bulk<std::uint64_t, 33, 0xFF51AFD7ED558CCD, 0xC4CEB9FE1A85EC53> ( in_, out_, n_, fmix64 );
+}
+
 template<typename T, typename = std::enable_if_t<std::conjunction_v<std::is_integral<T>, std::is_unsigned<T>>>>
 constexpr std::uint32_t popCount ( T const x_ ) noexcept {
+#if defined( _MSC_VER ) and not defined( __clang__ )
     if constexpr ( std::is_same<T, std::uint64_t>::value ) {
         return ( std::uint32_t ) __popcnt64 ( x_ );
     }
     else {
         return ( std::uint32_t ) __popcnt ( ( std::uint32_t ) x_ );
     }
+#else
+    if constexpr ( std::is_same<T, std::uint64_t>::value ) {
+        return ( std::uint32_t ) __builtin_popcountll ( x_ );
+    }
+    else {
+        return ( std::uint32_t ) __builtin_popcount ( ( std::uint32_t ) x_ );
+    }
+#endif
+}
+
+namespace integer_detail {
+[[nodiscard]] inline std::uint64_t popcount_words ( std::uint64_t const * p_, std::size_t const n_ ) noexcept {
+    std::uint64_t c = 0u;
+    for ( std::size_t i = 0u; i < n_; ++i )
+        c += popCount ( p_[ i ] );
+    return c;
+}
+
+#if defined( __GNUC__ ) and ( defined( __x86_64__ ) or defined( __i386__ ) )
+// Compiled for the instruction sets in the target attributes, called after checking the cpu supports them.
+__attribute__ ( ( target ( "popcnt" ) ) ) inline std::uint64_t popcount_popcnt ( std::uint64_t const * p_,
+                                                                               std::size_t const n_ ) noexcept {
+    return popcount_words ( p_, n_ );
+}
+
+// The bytes of x_ counted with 2 nibble-table look-ups (vpshufb), summed in the 4 64-bit lanes.
+__attribute__ ( ( target ( "avx2" ) ) ) inline __m256i popcount_256 ( __m256i const x_ ) noexcept {
+    __m256i const table = _mm256_setr_epi8 ( 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 );
+    __m256i const nibble = _mm256_set1_epi8 ( 0x0F );
+    __m256i const lo     = _mm256_shuffle_epi8 ( table, _mm256_and_si256 ( x_, nibble ) );
+    __m256i const hi     = _mm256_shuffle_epi8 ( table, _mm256_and_si256 ( _mm256_srli_epi16 ( x_, 4 ), nibble ) );
+    return _mm256_sad_epu8 ( _mm256_add_epi8 ( lo, hi ), _mm256_setzero_si256 ( ) );
+}
+
+// Carry-save adder, h_ : l_ = a_ + b_ + c_, bitwise.
+__attribute__ ( ( target ( "avx2" ) ) ) inline void csa ( __m256i & h_, __m256i & l_, __m256i const a_, __m256i const b_,
+                                                         __m256i const c_ ) noexcept {
+    __m256i const u = _mm256_xor_si256 ( a_, b_ );
+    h_              = _mm256_or_si256 ( _mm256_and_si256 ( a_, b_ ), _mm256_and_si256 ( u, c_ ) );
+    l_              = _mm256_xor_si256 ( u, c_ );
+}
+
+// Harley-Seal (Muła, Kurz, Lemire, "Faster Population Counts Using AVX2 Instructions", 2016), 16 vectors are reduced
+// with a tree of carry-save adders, one vpshufb count per 16 vectors.
+__attribute__ ( ( target ( "avx2,popcnt" ) ) ) inline std::uint64_t popcount_avx2 ( std::uint64_t const * p_,
+                                                                                  std::size_t const n_ ) noexcept {
+    __m256i const * const v = reinterpret_cast<__m256i const *> ( p_ );
+    std::size_t const size  = n_ / 4u;
+    __m256i total = _mm256_setzero_si256 ( ), ones = total, twos = total, fours = total, eights = total, sixteens;
+    __m256i twos_a, twos_b, fours_a, fours_b, eights_a, eights_b;
+    std::size_t i = 0u;
+    for ( ; i + 16u <= size; i += 16u ) {
+        csa ( twos_a, ones, ones, _mm256_loadu_si256 ( v + i + 0u ), _mm256_loadu_si256 ( v + i + 1u ) );
+        csa ( twos_b, ones, ones, _mm256_loadu_si256 ( v + i + 2u ), _mm256_loadu_si256 ( v + i + 3u ) );
+        csa ( fours_a, twos, twos, twos_a, twos_b );
+        csa ( twos_a, ones, ones, _mm256_loadu_si256 ( v + i + 4u ), _mm256_loadu_si256 ( v + i + 5u ) );
+        csa ( twos_b, ones, ones, _mm256_loadu_si256 ( v + i + 6u ), _mm256_loadu_si256 ( v + i + 7u ) );
+        csa ( fours_b, twos, twos, twos_a, twos_b );
+        csa ( eights_a, fours, fours, fours_a, fours_b );
+        csa ( twos_a, ones, ones, _mm256_loadu_si256 ( v + i + 8u ), _mm256_loadu_si256 ( v + i + 9u ) );
+        csa ( twos_b, ones, ones, _mm256_loadu_si256 ( v + i + 10u ), _mm256_loadu_si256 ( v + i + 11u ) );
+        csa ( fours_a, twos, twos, twos_a, twos_b );
+        csa ( twos_a, ones, ones, _mm256_loadu_si256 ( v + i + 12u ), _mm256_loadu_si256 ( v + i + 13u ) );
+        csa ( twos_b, ones, ones, _mm256_loadu_si256 ( v + i + 14u ), _mm256_loadu_si256 ( v + i + 15u ) );
+        csa ( fours_b, twos, twos, twos_a, twos_b );
+        csa ( eights_b, fours, fours, fours_a, fours_b );
+        csa ( sixteens, eights, eights, eights_a, eights_b );
+        total = _mm256_add_epi64 ( total, popcount_256 ( sixteens ) );
+    }
+    total = _mm256_slli_epi64 ( total, 4 );
+    total = _mm256_add_epi64 ( total, _mm256_slli_epi64 ( popcount_256 ( eights ), 3 ) );
+    total = _mm256_add_epi64 ( total, _mm256_slli_epi64 ( popcount_256 ( fours ), 2 ) );
+    total = _mm256_add_epi64 ( total, _mm256_slli_epi64 ( popcount_256 ( twos ), 1 ) );
+    total = _mm256_add_epi64 ( total, popcount_256 ( ones ) );
+    for ( ; i < size; ++i )
+        total = _mm256_add_epi64 ( total, popcount_256 ( _mm256_loadu_si256 ( v + i ) ) );
+    alignas ( 32 ) std::uint64_t lanes[ 4 ];
+    _mm256_store_si256 ( reinterpret_cast<__m256i *> ( lanes ), total );
+    return lanes[ 0 ] + lanes[ 1 ] + lanes[ 2 ] + lanes[ 3 ] + popcount_words ( p_ + 4u * size, n_ - 4u * size );
+}
+
+__attribute__ ( ( target ( "avx512f,avx512vpopcntdq" ) ) ) inline std::uint64_t popcount_avx512 ( std::uint64_t const * p_,
+                                                                                                 std::size_t const n_ ) noexcept {
+    __m512i total = _mm512_setzero_si512 ( );
+    std::size_t i = 0u;
+    for ( ; i + 8u <= n_; i += 8u )
+        total = _mm512_add_epi64 ( total, _mm512_popcnt_epi64 ( _mm512_loadu_si512 ( p_ + i ) ) );
+    __mmask8 const tail = static_cast<__mmask8> ( ( 1u << ( n_ - i ) ) - 1u );
+    total               = _mm512_add_epi64 ( total, _mm512_popcnt_epi64 ( _mm512_maskz_loadu_epi64 ( tail, p_ + i ) ) );
+    alignas ( 64 ) std::uint64_t lanes[ 8 ];
+    _mm512_store_si512 ( lanes, total );
+    return lanes[ 0 ] + lanes[ 1 ] + lanes[ 2 ] + lanes[ 3 ] + lanes[ 4 ] + lanes[ 5 ] + lanes[ 6 ] + lanes[ 7 ];
+}
+
+using popcount_function = std::uint64_t ( * ) ( std::uint64_t const *, std::size_t );
+
+[[nodiscard]] inline popcount_function select_popcount ( ) noexcept {
+    __builtin_cpu_init ( );
+    if ( __builtin_cpu_supports ( "avx512vpopcntdq" ) )
+        return popcount_avx512;
+    if ( __builtin_cpu_supports ( "avx2" ) )
+        return popcount_avx2;
+    if ( __builtin_cpu_supports ( "popcnt" ) )
+        return popcount_popcnt;
+    return popcount_words;
+}
+#endif
+} // namespace integer_detail
+
+// The number of set bits in the n_ words at p_. With gcc and clang on x86, the implementation is chosen at run-time, on
+// the first call: AVX-512 VPOPCNTDQ, AVX2 (Harley-Seal with vpshufb nibble counts), or popcnt, whichever the cpu supports
+// first, otherwise (and elsewhere) a loop over popCount ( ).
+[[nodiscard]] inline std::uint64_t popcount_bulk ( std::uint64_t const * p_, std::size_t const n_ ) noexcept {
+#if defined( __GNUC__ ) and ( defined( __x86_64__ ) or defined( __i386__ ) )
+    static integer_detail::popcount_function const popcount = integer_detail::select_popcount ( );
+    return popcount ( p_, n_ );
+#else
+    return integer_detail::popcount_words ( p_, n_ );
+#endif
 }
 
 template<typename T, typename = std::enable_if_t<std::is_integral<T>::value>>
@@ -292,21 +802,89 @@ void print_bits ( T const n_ ) noexcept {
     }
 }
 
-// Integer square root.
+namespace integer_detail {
+// True while the call is evaluated at compile-time (where std::sqrt can't be used), without a builtin always true.
+[[nodiscard]] inline constexpr bool is_constant_evaluated ( ) noexcept {
+#if defined( __cpp_lib_is_constant_evaluated )
+    return std::is_constant_evaluated ( );
+#elif defined( __GNUC__ ) or defined( __clang__ ) or ( defined( _MSC_VER ) and _MSC_VER >= 1925 )
+    return __builtin_is_constant_evaluated ( );
+#else
+    return true;
+#endif
+}
+
+template<typename T, bool = ( sizeof ( T ) > 8u )>
+struct make_unsigned {
+    using type = std::make_unsigned_t<T>;
+};
+#if defined( __SIZEOF_INT128__ )
+template<typename T>
+struct make_unsigned<T, true> {
+    using type = __uint128_t;
+};
+#endif
+
+// floor ( sqrt ( n_ ) ), digit by digit.
+template<typename T>
+[[nodiscard]] constexpr T isqrt_bits ( T n_ ) noexcept {
+    T r = 0u, b = T ( 1 ) << ( sizeof ( T ) * 8u - 2u );
+    while ( b > n_ )
+        b >>= 2;
+    for ( ; b; b >>= 2 ) {
+        if ( n_ >= r + b ) {
+            n_ -= r + b;
+            r = ( r >> 1 ) + b;
+        }
+        else {
+            r >>= 1;
+        }
+    }
+    return r;
+}
+} // namespace integer_detail
+
+// Integer square root, floor ( sqrt ( val_ ) ), exact for all values up to 64 (128) bits. The double estimate is exact
+// below 2 ^ 52 and off by at most 1 above, which one compare on either side corrects, the 128-bit estimate takes a Newton
+// step first. At compile-time the root is computed digit by digit.
 template<typename SizeType>
 [[nodiscard]] inline constexpr SizeType isqrt ( SizeType const val_ ) noexcept {
-    assert ( val_ > 0 );
-    return static_cast<SizeType> ( std::sqrt ( static_cast<double> ( val_ ) ) );
+    using T = typename integer_detail::make_unsigned<SizeType>::type;
+    assert ( val_ >= 0 );
+    T const n = static_cast<T> ( val_ );
+    if ( integer_detail::is_constant_evaluated ( ) )
+        return static_cast<SizeType> ( integer_detail::isqrt_bits ( n ) );
+    if constexpr ( sizeof ( T ) <= 4u ) {
+        return static_cast<SizeType> ( std::sqrt ( static_cast<double> ( n ) ) );
+    }
+    else {
+        constexpr T max = ( T ( 1 ) << ( sizeof ( T ) * 4u ) ) - 1u; // The largest root.
+        T r             = static_cast<T> ( std::sqrt ( static_cast<double> ( n ) ) );
+        if constexpr ( sizeof ( T ) > 8u ) {
+            if ( r )
+                r = ( r + n / r ) / 2u;
+        }
+        r = r < max ? r : max;
+        r -= r * r > n;
+        r += r < max and ( r + 1u ) * ( r + 1u ) <= n;
+        return static_cast<SizeType> ( r );
+    }
 }
 
+// The r_-th triangular number, r_ ( r_ + 1 ) / 2, as the odd factor times half the even one, which doesn't overflow if
+// the result doesn't.
 template<typename SizeType>
-[[nodiscard]] static constexpr std::size_t nth_triangular ( SizeType r_ ) noexcept {
-    r_ += 1;
-    return r_ * ( r_ - 1 ) / 2;
+[[nodiscard]] static constexpr SizeType nth_triangular ( SizeType r_ ) noexcept {
+    return ( r_ | 1 ) * ( ( r_ + 1 ) >> 1 );
 }
+// The smallest r with nth_triangular ( r ) >= n_, n_ < 2 ^ ( bits - 1 ) (2 * n_ is computed unsigned, so this holds for
+// all non-negative n_ of a signed type).
 template<typename SizeType>
 [[nodiscard]] static constexpr SizeType nth_triangular_root ( SizeType n_ ) noexcept {
-    return ( isqrt ( 8 * n_ ) + 1 ) / 2;
+    using T   = typename integer_detail::make_unsigned<SizeType>::type;
+    T const m = static_cast<T> ( 2u * static_cast<T> ( n_ ) );
+    T const s = isqrt ( m ); // The root is s or s + 1.
+    return static_cast<SizeType> ( s + ( s * ( s + 1u ) < m ) );
 }
 
 template<typename SizeType>
@@ -323,6 +901,31 @@ template<typename SizeType>
     return nth_triangular ( nth_triangular_root ( n_ ) + 1 );
 }
 
+// Row and column of an element of a packed triangular matrix.
+template<typename SizeType>
+struct row_col_type {
+    SizeType row, col;
+};
+
+// The linear index n_ of the row-major lower triangle, diagonal included, element ( r, c ), c <= r, is at
+// nth_triangular ( r ) + c (this is also the column-major upper triangle, with row and column swapped), n_ < 2 ^ ( bits - 1 )
+// as for nth_triangular_root ( ).
+template<typename SizeType>
+[[nodiscard]] static constexpr row_col_type<SizeType> triangular_row_col ( SizeType n_ ) noexcept {
+    using T          = typename integer_detail::make_unsigned<SizeType>::type;
+    T const m        = static_cast<T> ( 2u * static_cast<T> ( n_ ) );
+    T const s        = isqrt ( m );
+    SizeType const r = static_cast<SizeType> ( s - ( s * ( s + 1u ) > m ) );
+    return { r, static_cast<SizeType> ( n_ - nth_triangular ( r ) ) };
+}
+
+// out_[ i ] = triangular_row_col ( in_[ i ] ).
+template<typename SizeType>
+void triangular_row_col_bulk ( SizeType const * in_, row_col_type<SizeType> * out_, std::size_t const n_ ) noexcept {
+    for ( std::size_t i = 0u; i < n_; ++i )
+        out_[ i ] = triangular_row_col ( in_[ i ] );
+}
+
 template<typename SizeType>
 struct span_type {
     SizeType begin, end;
@@ -12,6 +12,8 @@
  *         - added namespace sax;
  *         - added seed () member function;
  *         - added seeding of the whole state (non-standard, should use seed_seq);
+ *         - added discard () member function;
+ *         - added generate () member function;
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -34,6 +36,7 @@
 
 /* Based on code published by Bob Jenkins in 2007, adapted for C++ */
 
+#include <cstddef>
 #include <cstdint>
 #include <utility>
 
@@ -51,6 +54,14 @@ class alignas ( 64 ) jsf {
 
     static itype rotate ( itype x, unsigned int k ) { return ( x << k ) | ( x >> ( ITYPE_BITS - k ) ); }
 
+    static void step ( itype & a, itype & b, itype & c, itype & d ) {
+        itype e = a - rotate ( b, p );
+        a       = b ^ rotate ( c, q );
+        b       = c + ( r ? rotate ( d, r ) : d );
+        c       = d + e;
+        d       = e + a;
+    }
+
     public:
     using result_type = rtype;
     using state_type  = itype;
@@ -58,7 +69,7 @@ class alignas ( 64 ) jsf {
     static constexpr result_type min ( ) { return 0; }
     static constexpr result_type max ( ) { return ~result_type ( 0 ); }
 
-    jsf ( itype seed = itype ( 0xcafe5eed00000001ULL ) ) : a_ ( 0xf1ea5eed ), b_ ( seed ), c_ ( seed ), d_ ( seed ) {}
+    jsf ( itype seed = itype ( 0xcafe5eed00000001ULL ) ) : a_ ( static_cast<itype> ( 0xf1ea5eed ) ), b_ ( seed ), c_ ( seed ), d_ ( seed ) {}
 
     jsf ( itype && seed1, itype && seed2, itype && seed3, itype && seed4 ) :
         a_ ( std::move ( seed4 ) ), b_ ( std::move ( seed3 ) ), c_ ( std::move ( seed2 ) ),
@@ -68,7 +79,7 @@ class alignas ( 64 ) jsf {
     }
 
     void seed ( const itype seed = itype ( 0xcafe5eed00000001ULL ) ) {
-        a_ = 0xf1ea5eed;
+        a_ = static_cast<itype> ( 0xf1ea5eed );
         b_ = seed;
         c_ = seed;
         d_ = seed;
@@ -83,12 +94,20 @@ class alignas ( 64 ) jsf {
             advance ( );
     }
 
-    void advance ( ) {
-        itype e = a_ - rotate ( b_, p );
-        a_      = b_ ^ rotate ( c_, q );
-        b_      = c_ + ( r ? rotate ( d_, r ) : d_ );
-        c_      = d_ + e;
-        d_      = e + a_;
+    void advance ( ) { step ( a_, b_, c_, d_ ); }
+
+    // Discards n values, the state is kept in locals and the loop is unrolled.
+    void discard ( unsigned long long n ) {
+        itype a = a_, b = b_, c = c_, d = d_;
+        for ( ; n >= 4; n -= 4 ) {
+            step ( a, b, c, d );
+            step ( a, b, c, d );
+            step ( a, b, c, d );
+            step ( a, b, c, d );
+        }
+        while ( n-- )
+            step ( a, b, c, d );
+        a_ = a, b_ = b, c_ = c, d_ = d;
     }
 
     rtype operator( ) ( ) {
@@ -96,6 +115,26 @@ class alignas ( 64 ) jsf {
         return rtype ( d_ );
     }
 
+    // Fills [ out, out + n ), the state is kept in locals and the loop is unrolled.
+    void generate ( result_type * out, std::size_t n ) {
+        itype a = a_, b = b_, c = c_, d = d_;
+        for ( ; n >= 4; n -= 4, out += 4 ) {
+            step ( a, b, c, d );
+            out[ 0 ] = rtype ( d );
+            step ( a, b, c, d );
+            out[ 1 ] = rtype ( d );
+            step ( a, b, c, d );
+            out[ 2 ] = rtype ( d );
+            step ( a, b, c, d );
+            out[ 3 ] = rtype ( d );
+        }
+        while ( n-- ) {
+            step ( a, b, c, d );
+            *out++ = rtype ( d );
+        }
+        a_ = a, b_ = b, c_ = c, d_ = d;
+    }
+
     bool operator== ( const jsf & rhs ) { return ( a_ == rhs.a_ ) && ( b_ == rhs.b_ ) && ( c_ == rhs.c_ ) && ( d_ == rhs.d_ ); }
 
     bool operator!= ( const jsf & rhs ) { return !operator== ( rhs ); }
@@ -13,6 +13,8 @@
  * degski: eliminated passing the multiplier as a template parameter to
  *         work around an ICE in Clang/LLVM front-end.
  *         added seed function.
+ *         added jump-ahead (advance ( delta ), discard ( n ) and split ( k )).
+ *         added generate ( out, n ).
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -33,12 +35,36 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include <cstddef>
 #include <cstdint>
 
+#include <vector>
+
 namespace sax {
 
 namespace lehmer_detail {
 
+// Returns mult ^ power (mod 2 ^ 128), by repeated squaring, in O(log power).
+template<typename stype>
+constexpr stype mult_pow ( stype mult, stype power ) noexcept {
+    stype result = stype ( 1 );
+    while ( power ) {
+        if ( power & stype ( 1 ) )
+            result *= mult;
+        mult *= mult;
+        power >>= 1;
+    }
+    return result;
+}
+
+// Returns mult ^ ( 2 ^ 64 ) (mod 2 ^ 128).
+template<typename stype>
+constexpr stype mult_pow_2_64 ( stype mult ) noexcept {
+    for ( int i = 0; i < 64; ++i )
+        mult *= mult;
+    return mult;
+}
+
 template<typename rtype, typename stype>
 class mcg128 {
     stype state_;
@@ -61,17 +87,56 @@ class mcg128 {
 
     void advance ( ) { state_ *= MCG_MULT; }
 
+    // Jumps ahead delta steps in O(log delta).
+    void advance ( stype delta ) { state_ *= mult_pow<stype> ( MCG_MULT, delta ); }
+
+    void discard ( unsigned long long n ) { advance ( stype ( n ) ); }
+
+    // Returns k generators, the first in the current state of this one, each next one 2 ^ 64 steps further ahead, i.e.
+    // k non-overlapping sub-streams (of 2 ^ 64 values each). This generator is not advanced.
+    [[nodiscard]] std::vector<mcg128> split ( std::size_t k ) const {
+        constexpr stype stride = mult_pow_2_64<stype> ( MCG_MULT );
+        std::vector<mcg128> generators;
+        generators.reserve ( k );
+        mcg128 g = *this;
+        for ( std::size_t i = 0; i < k; ++i, g.state_ *= stride )
+            generators.push_back ( g );
+        return generators;
+    }
+
     result_type operator( ) ( ) {
         advance ( );
         return result_type ( state_ >> ( STYPE_BITS - RTYPE_BITS ) );
     }
 
+    // Fills [ out, out + n ), runs 4 interleaved states (multiplied by MCG_MULT ^ 4), hiding the latency of the
+    // 128-bit multiplies.
+    void generate ( result_type * out, std::size_t n ) {
+        constexpr stype mult_4 = mult_pow<stype> ( MCG_MULT, 4 );
+        if ( n >= 4 ) {
+            stype s0 = state_ * MCG_MULT, s1 = s0 * MCG_MULT, s2 = s1 * MCG_MULT, s3 = s2 * MCG_MULT;
+            for ( ; n >= 8; n -= 4, out += 4 ) {
+                out[ 0 ] = result_type ( s0 >> ( STYPE_BITS - RTYPE_BITS ) );
+                out[ 1 ] = result_type ( s1 >> ( STYPE_BITS - RTYPE_BITS ) );
+                out[ 2 ] = result_type ( s2 >> ( STYPE_BITS - RTYPE_BITS ) );
+                out[ 3 ] = result_type ( s3 >> ( STYPE_BITS - RTYPE_BITS ) );
+                s0 *= mult_4, s1 *= mult_4, s2 *= mult_4, s3 *= mult_4;
+            }
+            out[ 0 ] = result_type ( s0 >> ( STYPE_BITS - RTYPE_BITS ) );
+            out[ 1 ] = result_type ( s1 >> ( STYPE_BITS - RTYPE_BITS ) );
+            out[ 2 ] = result_type ( s2 >> ( STYPE_BITS - RTYPE_BITS ) );
+            out[ 3 ] = result_type ( s3 >> ( STYPE_BITS - RTYPE_BITS ) );
+            state_ = s3, n -= 4, out += 4;
+        }
+        while ( n-- )
+            *out++ = operator( ) ( );
+    }
+
     bool operator== ( const mcg128 & rhs ) { return ( state_ == rhs.state_ ); }
 
     bool operator!= ( const mcg128 & rhs ) { return !operator== ( rhs ); }
 
     // Not (yet) implemented:
-    //   - arbitrary jumpahead (see PCG code for an implementation)
     //   - I/O
     //   - Seeding from a seed_seq.
 };
@@ -97,17 +162,49 @@ class mcg128_fast {
 
     void advance ( ) { state_ *= MCG_MULT; }
 
+    // Jumps ahead delta steps in O(log delta).
+    void advance ( stype delta ) { state_ *= mult_pow<stype> ( MCG_MULT, delta ); }
+
+    void discard ( unsigned long long n ) { advance ( stype ( n ) ); }
+
+    // Returns k generators, the first in the current state of this one, each next one 2 ^ 64 steps further ahead, i.e.
+    // k non-overlapping sub-streams (of 2 ^ 64 values each). This generator is not advanced.
+    [[nodiscard]] std::vector<mcg128_fast> split ( std::size_t k ) const {
+        constexpr stype stride = mult_pow_2_64<stype> ( MCG_MULT );
+        std::vector<mcg128_fast> generators;
+        generators.reserve ( k );
+        mcg128_fast g = *this;
+        for ( std::size_t i = 0; i < k; ++i, g.state_ *= stride )
+            generators.push_back ( g );
+        return generators;
+    }
+
     result_type operator( ) ( ) {
         advance ( );
         return result_type ( state_ >> ( STYPE_BITS - RTYPE_BITS ) );
     }
 
+    // Fills [ out, out + n ), one state kept in a local, stepped by the 64-bit MCG_MULT (4 interleaved states would
+    // have to be stepped by MCG_MULT ^ 4, a full 128-bit multiplier, which costs more than it hides).
+    void generate ( result_type * out, std::size_t n ) {
+        stype s = state_;
+        for ( ; n >= 4; n -= 4, out += 4 ) {
+            s *= MCG_MULT, out[ 0 ] = result_type ( s >> ( STYPE_BITS - RTYPE_BITS ) );
+            s *= MCG_MULT, out[ 1 ] = result_type ( s >> ( STYPE_BITS - RTYPE_BITS ) );
+            s *= MCG_MULT, out[ 2 ] = result_type ( s >> ( STYPE_BITS - RTYPE_BITS ) );
+            s *= MCG_MULT, out[ 3 ] = result_type ( s >> ( STYPE_BITS - RTYPE_BITS ) );
+        }
+        for ( ; n; --n ) {
+            s *= MCG_MULT, *out++ = result_type ( s >> ( STYPE_BITS - RTYPE_BITS ) );
+        }
+        state_ = s;
+    }
+
     bool operator== ( const mcg128_fast & rhs ) { return ( state_ == rhs.state_ ); }
 
     bool operator!= ( const mcg128_fast & rhs ) { return !operator== ( rhs ); }
 
     // Not (yet) implemented:
-    //   - arbitrary jumpahead (see PCG code for an implementation)
     //   - I/O
     //   - Seeding from a seed_seq.
 };
@@ -0,0 +1,210 @@
+
+// MIT License
+//
+// Copyright (c) 2020 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+
+#include <immintrin.h>
+
+#include "splitmix.hpp"
+
+#ifdef __AVX2__
+
+// Multi-lane SFC and JSF generators, running 4 (64-bit) or 8 (32-bit) independent generators side by side in AVX2
+// registers. Lane i produces exactly the sequence of the scalar generator (sfc.hpp, jsf.hpp) seeded, with its fully
+// seeding constructor, from the i-th split ( ) of a splitmix64 seeded with the seed. The output interleaves the lanes,
+// i.e. a step produces one value from each lane, in lane order.
+
+namespace sax {
+
+namespace avx2_detail {
+
+template<unsigned int k>
+[[nodiscard]] inline __m256i rotl64 ( __m256i x ) noexcept {
+    return _mm256_or_si256 ( _mm256_slli_epi64 ( x, k ), _mm256_srli_epi64 ( x, 64 - k ) );
+}
+template<unsigned int k>
+[[nodiscard]] inline __m256i rotl32 ( __m256i x ) noexcept {
+    return _mm256_or_si256 ( _mm256_slli_epi32 ( x, k ), _mm256_srli_epi32 ( x, 32 - k ) );
+}
+
+// Buffers one step, so single values can be drawn, Gen supplies step ( ) returning the next __m256i.
+template<typename Gen, typename rtype>
+class lanes {
+    protected:
+    static constexpr std::size_t lane_count = sizeof ( __m256i ) / sizeof ( rtype );
+
+    alignas ( 32 ) rtype buffer_[ lane_count ];
+    std::size_t index_ = lane_count;
+
+    public:
+    using result_type = rtype;
+
+    static constexpr result_type min ( ) { return 0; }
+    static constexpr result_type max ( ) { return ~result_type ( 0 ); }
+
+    static constexpr std::size_t lanes_size ( ) noexcept { return lane_count; }
+
+    result_type operator( ) ( ) {
+        if ( lane_count == index_ ) {
+            _mm256_store_si256 ( reinterpret_cast<__m256i *> ( buffer_ ), static_cast<Gen *> ( this )->step ( ) );
+            index_ = 0;
+        }
+        return buffer_[ index_++ ];
+    }
+
+    // Fills [ it, end ), continuing the sequence of operator ( ). Whole steps are written at once through pointers and
+    // random access iterators, other (output, forward, ...) iterators are filled value by value.
+    template<typename It>
+    void generate ( It it, const It end ) {
+        while ( it != end and index_ != lane_count )
+            *it++ = buffer_[ index_++ ];
+        if constexpr ( std::is_same<It, result_type *>::value ) {
+            for ( ; static_cast<std::size_t> ( end - it ) >= lane_count; it += lane_count )
+                _mm256_storeu_si256 ( reinterpret_cast<__m256i *> ( it ), static_cast<Gen *> ( this )->step ( ) );
+        }
+        else if constexpr ( std::is_base_of<std::random_access_iterator_tag,
+                                            typename std::iterator_traits<It>::iterator_category>::value ) {
+            for ( ; static_cast<std::size_t> ( end - it ) >= lane_count; it += lane_count ) {
+                _mm256_store_si256 ( reinterpret_cast<__m256i *> ( buffer_ ), static_cast<Gen *> ( this )->step ( ) );
+                std::copy ( buffer_, buffer_ + lane_count, it );
+            }
+        }
+        while ( it != end )
+            *it++ = operator( ) ( );
+    }
+
+    void generate ( result_type * out, std::size_t n ) { generate ( out, out + n ); }
+
+    void discard ( unsigned long long n_ ) {
+        while ( n_-- )
+            ( void ) operator( ) ( );
+    }
+};
+
+template<unsigned int p, unsigned int q, unsigned int r>
+class alignas ( 32 ) sfc64x4 : public lanes<sfc64x4<p, q, r>, std::uint64_t> {
+    friend class lanes<sfc64x4, std::uint64_t>;
+
+    __m256i a_, b_, c_, d_;
+
+    [[nodiscard]] __m256i step ( ) noexcept {
+        __m256i const tmp = _mm256_add_epi64 ( _mm256_add_epi64 ( a_, b_ ), d_ );
+        d_                = _mm256_add_epi64 ( d_, _mm256_set1_epi64x ( 1 ) );
+        a_                = _mm256_xor_si256 ( b_, _mm256_srli_epi64 ( b_, q ) );
+        b_                = _mm256_add_epi64 ( c_, _mm256_slli_epi64 ( c_, r ) );
+        c_                = _mm256_add_epi64 ( rotl64<p> ( c_ ), tmp );
+        return tmp;
+    }
+
+    public:
+    using state_type = std::uint64_t;
+
+    explicit sfc64x4 ( std::uint64_t seed = 0xcafef00dbeef5eedULL ) { this->seed ( seed ); }
+
+    void seed ( std::uint64_t seed ) {
+        alignas ( 32 ) std::uint64_t s[ 4 ][ 4 ];
+        splitmix64 master ( seed );
+        for ( int lane = 0; lane < 4; ++lane ) {
+            splitmix64 stream = master.split ( );
+            for ( int i = 0; i < 4; ++i )
+                s[ i ][ lane ] = stream ( );
+        }
+        // As the fully seeding constructor of the scalar sfc: seed1 goes (made odd) to d, seed4 to a.
+        d_ = _mm256_or_si256 ( _mm256_load_si256 ( reinterpret_cast<__m256i const *> ( s[ 0 ] ) ), _mm256_set1_epi64x ( 1 ) );
+        c_ = _mm256_load_si256 ( reinterpret_cast<__m256i const *> ( s[ 1 ] ) );
+        b_ = _mm256_load_si256 ( reinterpret_cast<__m256i const *> ( s[ 2 ] ) );
+        a_ = _mm256_load_si256 ( reinterpret_cast<__m256i const *> ( s[ 3 ] ) );
+        for ( int i = 0; i < 20; ++i )
+            ( void ) step ( );
+        this->index_ = this->lane_count;
+    }
+};
+
+template<unsigned int p, unsigned int q, unsigned int r>
+class alignas ( 32 ) jsf32x8 : public lanes<jsf32x8<p, q, r>, std::uint32_t> {
+    friend class lanes<jsf32x8, std::uint32_t>;
+
+    __m256i a_, b_, c_, d_;
+
+    void advance ( ) noexcept {
+        __m256i const e = _mm256_sub_epi32 ( a_, rotl32<p> ( b_ ) );
+        a_              = _mm256_xor_si256 ( b_, rotl32<q> ( c_ ) );
+        if constexpr ( r )
+            b_ = _mm256_add_epi32 ( c_, rotl32<r> ( d_ ) );
+        else
+            b_ = _mm256_add_epi32 ( c_, d_ );
+        c_ = _mm256_add_epi32 ( d_, e );
+        d_ = _mm256_add_epi32 ( e, a_ );
+    }
+
+    [[nodiscard]] __m256i step ( ) noexcept {
+        advance ( );
+        return d_;
+    }
+
+    public:
+    using state_type = std::uint32_t;
+
+    explicit jsf32x8 ( std::uint64_t seed = 0xcafe5eed00000001ULL ) { this->seed ( seed ); }
+
+    void seed ( std::uint64_t seed ) {
+        alignas ( 32 ) std::uint32_t s[ 4 ][ 8 ];
+        splitmix64 master ( seed );
+        for ( int lane = 0; lane < 8; ++lane ) {
+            splitmix64 stream = master.split ( );
+            for ( int i = 0; i < 4; ++i )
+                s[ i ][ lane ] = static_cast<std::uint32_t> ( stream ( ) );
+        }
+        // As the fully seeding constructor of the scalar jsf: seed1 goes (made odd) to d, seed4 to a.
+        d_ = _mm256_or_si256 ( _mm256_load_si256 ( reinterpret_cast<__m256i const *> ( s[ 0 ] ) ), _mm256_set1_epi32 ( 1 ) );
+        c_ = _mm256_load_si256 ( reinterpret_cast<__m256i const *> ( s[ 1 ] ) );
+        b_ = _mm256_load_si256 ( reinterpret_cast<__m256i const *> ( s[ 2 ] ) );
+        a_ = _mm256_load_si256 ( reinterpret_cast<__m256i const *> ( s[ 3 ] ) );
+        for ( int i = 0; i < 20; ++i )
+            advance ( );
+        this->index_ = this->lane_count;
+    }
+};
+
+} // namespace avx2_detail
+
+// 4 x sfc64a, 4 x 256 state bits, uint64_t output.
+using sfc64x4 = avx2_detail::sfc64x4<24, 11, 3>;
+
+// 8 x jsf32na, 8 x 128 state bits, uint32_t output.
+using jsf32x8 = avx2_detail::jsf32x8<27, 17, 0>;
+
+} // namespace sax
+
+#else
+
+#error "prng_avx2.hpp requires AVX2 (compile with -mavx2, or a -march that has it)"
+
+#endif
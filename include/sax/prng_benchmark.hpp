@@ -0,0 +1,184 @@
+
+// MIT License
+//
+// Copyright (c) 2020 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <chrono>
+#include <vector>
+
+#ifdef _WIN32
+#    include <fcntl.h>
+#    include <io.h>
+#endif
+
+#include "detail/benchmark.hpp"
+#include "jsf.hpp"
+#include "sfc.hpp"
+#include "splitmix.hpp"
+#if defined( __SIZEOF_INT128__ )
+#    include "lehmer.hpp"
+#endif
+#ifdef __AVX2__
+#    include "prng_avx2.hpp"
+#endif
+#include "uniform_int_distribution.hpp"
+
+// Throughput of the sax generators, raw and with sax::uniform_int_distribution on top, and a raw output stream for
+// piping into PractRand (RNG_test stdin64) or TestU01. A complete benchmark program is:
+//
+//     #include <sax/prng_benchmark.hpp>
+//
+//     int main ( int argc, char ** argv ) { return sax::prng_benchmark_main ( argc, argv ); }
+//
+// Without arguments it prints a table of all generators, with "--stream <name>" it writes the raw output of the named
+// generator to stdout (until the pipe closes), f.e. "./bench --stream sfc64 | RNG_test stdin64".
+
+namespace sax {
+
+struct prng_benchmark_result {
+    char const * name;
+    double ns_per_value;       // generate ( out, n ), in cache.
+    double gb_per_second;      // Idem.
+    double distribution_ns;    // sax::uniform_int_distribution<std::uint32_t> ( 0, 999'999 ) per value.
+};
+
+namespace prng_benchmark_detail {
+
+inline constexpr std::size_t buffer_size = std::size_t{ 1 } << 14; // Values, stays in L1/L2.
+
+// Calls f_ ( gen ) for every generator, with its name.
+template<typename Function>
+void for_each_generator ( Function f_ ) {
+    f_ ( "splitmix64", splitmix64 { } );
+    f_ ( "splitmix32", splitmix32 { } );
+    f_ ( "sfc8", sfc8 { } );
+    f_ ( "sfc16", sfc16 { } );
+    f_ ( "sfc32", sfc32 { } );
+    f_ ( "sfc64", sfc64 { } );
+    f_ ( "jsf8", jsf8 { } );
+    f_ ( "jsf16", jsf16 { } );
+    f_ ( "jsf32", jsf32 { } );
+    f_ ( "jsf64", jsf64 { } );
+#if defined( __SIZEOF_INT128__ )
+    f_ ( "mcg128", mcg128 { } );
+    f_ ( "mcg128_fast", mcg128_fast { } );
+#endif
+#ifdef __AVX2__
+    f_ ( "sfc64x4", sfc64x4 { } );
+    f_ ( "jsf32x8", jsf32x8 { } );
+#endif
+}
+
+} // namespace prng_benchmark_detail
+
+// Measures gen_ over (at least) values_ values.
+template<typename Gen>
+[[nodiscard]] prng_benchmark_result benchmark_prng ( char const * name_, Gen gen_, std::size_t values_ = std::size_t{ 1 } << 27 ) {
+    using namespace benchmark_detail;
+    using namespace prng_benchmark_detail;
+    using result_type = typename Gen::result_type;
+    std::vector<result_type> buffer ( buffer_size );
+    std::size_t const rounds = ( values_ + buffer_size - 1 ) / buffer_size;
+    result_type sink         = 0;
+    gen_.generate ( buffer.data ( ), buffer.size ( ) ); // Warm up.
+    auto const t0 = std::chrono::steady_clock::now ( );
+    for ( std::size_t r = 0; r < rounds; ++r ) {
+        gen_.generate ( buffer.data ( ), buffer.size ( ) );
+        sink ^= buffer[ r % buffer_size ];
+    }
+    auto const t1 = std::chrono::steady_clock::now ( );
+    uniform_int_distribution<std::uint32_t> dis ( 0u, 999'999u );
+    std::uint32_t dis_sink = 0u;
+    std::size_t const dis_values = rounds * buffer_size / 4;
+    auto const t2                = std::chrono::steady_clock::now ( );
+    for ( std::size_t i = 0; i < dis_values; ++i )
+        dis_sink += dis ( gen_ );
+    auto const t3 = std::chrono::steady_clock::now ( );
+    keep_alive                = static_cast<std::uint64_t> ( sink ) + dis_sink;
+    double const values       = static_cast<double> ( rounds * buffer_size );
+    double const ns_per_value = nanoseconds ( t1 - t0 ) / values;
+    return { name_, ns_per_value, static_cast<double> ( sizeof ( result_type ) ) / ns_per_value,
+             nanoseconds ( t3 - t2 ) / static_cast<double> ( dis_values ) };
+}
+
+// Prints a table of all generators to out_.
+inline void benchmark_prngs ( std::FILE * out_ = stdout, std::size_t values_ = std::size_t{ 1 } << 27 ) {
+    std::fprintf ( out_, "%-12s %10s %10s %14s\n", "generator", "ns/value", "GB/s", "ns/uniform_int" );
+    prng_benchmark_detail::for_each_generator ( [ out_, values_ ] ( char const * name_, auto gen_ ) {
+        prng_benchmark_result const r = benchmark_prng ( name_, gen_, values_ );
+        std::fprintf ( out_, "%-12s %10.3f %10.3f %14.3f\n", r.name, r.ns_per_value, r.gb_per_second, r.distribution_ns );
+        std::fflush ( out_ );
+    } );
+}
+
+// Writes the raw output of gen_ to out_, until bytes_ bytes are written (0 is unbounded) or writing fails.
+template<typename Gen>
+void stream_prng ( Gen gen_, std::FILE * out_ = stdout, unsigned long long bytes_ = 0u ) {
+    using result_type = typename Gen::result_type;
+    std::vector<result_type> buffer ( prng_benchmark_detail::buffer_size );
+    std::size_t const block = buffer.size ( ) * sizeof ( result_type );
+    for ( unsigned long long written = 0u; not bytes_ or written < bytes_; written += block ) {
+        gen_.generate ( buffer.data ( ), buffer.size ( ) );
+        std::size_t const n = bytes_ and bytes_ - written < block ? static_cast<std::size_t> ( bytes_ - written ) : block;
+        if ( std::fwrite ( buffer.data ( ), 1, n, out_ ) != n )
+            return;
+    }
+    std::fflush ( out_ );
+}
+
+// Streams the generator with the name_ (as in the table) to out_, returns false iff there is no such generator.
+inline bool stream_prng_by_name ( char const * name_, std::FILE * out_ = stdout, unsigned long long bytes_ = 0u ) {
+    bool found = false;
+    prng_benchmark_detail::for_each_generator ( [ & found, name_, out_, bytes_ ] ( char const * gen_name_, auto gen_ ) {
+        if ( not found and not std::strcmp ( name_, gen_name_ ) ) {
+            found = true;
+            stream_prng ( gen_, out_, bytes_ );
+        }
+    } );
+    return found;
+}
+
+inline int prng_benchmark_main ( int argc, char ** argv ) {
+    if ( 1 == argc ) {
+        benchmark_prngs ( );
+        return EXIT_SUCCESS;
+    }
+    if ( 3 == argc and not std::strcmp ( argv[ 1 ], "--stream" ) ) {
+#ifdef _WIN32
+        _setmode ( _fileno ( stdout ), _O_BINARY );
+#endif
+        if ( stream_prng_by_name ( argv[ 2 ], stdout ) )
+            return EXIT_SUCCESS;
+        std::fprintf ( stderr, "unknown generator: %s\n", argv[ 2 ] );
+    }
+    std::fprintf ( stderr, "usage: %s [--stream <generator>]\n", argv[ 0 ] );
+    return EXIT_FAILURE;
+}
+
+} // namespace sax
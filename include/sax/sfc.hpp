@@ -11,6 +11,8 @@
  *    - changed constructors slightly;
  *    - added seed functions;
  *    - added fully seeding constructor;
+ *    - added discard;
+ *    - added generate;
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -35,6 +37,7 @@
  * random-number generation.
  */
 
+#include <cstddef>
 #include <cstdint>
 #include <utility>
 
@@ -51,6 +54,14 @@ class alignas ( 64 ) sfc {
 
     static itype rotate ( itype x, unsigned int k ) { return ( x << k ) | ( x >> ( ITYPE_BITS - k ) ); }
 
+    static itype step ( itype & a, itype & b, itype & c, itype & d ) {
+        itype tmp = a + b + d++;
+        a         = b ^ ( b >> q );
+        b         = c + ( c << r );
+        c         = rotate ( c, p ) + tmp;
+        return tmp;
+    }
+
     public:
     using result_type = rtype;
     using state_type  = itype;
@@ -87,12 +98,34 @@ class alignas ( 64 ) sfc {
 
     void advance ( ) { ( void ) operator( ) ( ); }
 
-    rtype operator( ) ( ) {
-        itype tmp = a_ + b_ + d_++;
-        a_        = b_ ^ ( b_ >> q );
-        b_        = c_ + ( c_ << r );
-        c_        = rotate ( c_, p ) + tmp;
-        return rtype ( tmp );
+    // Discards n values, the state is kept in locals and the loop is unrolled.
+    void discard ( unsigned long long n ) {
+        itype a = a_, b = b_, c = c_, d = d_;
+        for ( ; n >= 4; n -= 4 ) {
+            ( void ) step ( a, b, c, d );
+            ( void ) step ( a, b, c, d );
+            ( void ) step ( a, b, c, d );
+            ( void ) step ( a, b, c, d );
+        }
+        while ( n-- )
+            ( void ) step ( a, b, c, d );
+        a_ = a, b_ = b, c_ = c, d_ = d;
+    }
+
+    rtype operator( ) ( ) { return rtype ( step ( a_, b_, c_, d_ ) ); }
+
+    // Fills [ out, out + n ), the state is kept in locals and the loop is unrolled.
+    void generate ( result_type * out, std::size_t n ) {
+        itype a = a_, b = b_, c = c_, d = d_;
+        for ( ; n >= 4; n -= 4, out += 4 ) {
+            out[ 0 ] = rtype ( step ( a, b, c, d ) );
+            out[ 1 ] = rtype ( step ( a, b, c, d ) );
+            out[ 2 ] = rtype ( step ( a, b, c, d ) );
+            out[ 3 ] = rtype ( step ( a, b, c, d ) );
+        }
+        while ( n-- )
+            *out++ = rtype ( step ( a, b, c, d ) );
+        a_ = a, b_ = b, c_ = c, d_ = d;
     }
 
     bool operator== ( const sfc & rhs ) { return ( a_ == rhs.a_ ) && ( b_ == rhs.b_ ) && ( c_ == rhs.c_ ) && ( d_ == rhs.d_ ); }
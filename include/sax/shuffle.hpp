@@ -0,0 +1,241 @@
+
+// MIT License
+//
+// Copyright (c) 2020 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "uniform_int_distribution.hpp"
+
+// Shuffling and sampling without replacement, with Lemire's nearly divisionless bounded draws.
+//
+// shuffle: Fisher-Yates, drawing two bounded ints from one 64-bit word while i * ( i - 1 ) < 2 ^ 60 (Brackett-Rozinsky,
+//          Lemire, "Batched Ranged Random Integer Generation", 2024). Ranges (of trivial types) larger than the cache are
+//          first scattered into random buckets which fit the cache (Rao-Sandelius), which replaces the cache miss per
+//          element of Fisher-Yates by a few sequential passes.
+// sample:  k elements without replacement, in the order of the population (for forward iterators, like std::sample),
+//          with Floyd's algorithm if the population is random access and k is small relative to it, Vitter's
+//          algorithm A otherwise, and (the population being an input range) reservoir sampling with Li's algorithm L,
+//          which only draws O ( k log ( n / k ) ) random numbers.
+
+namespace sax {
+
+template<typename RandomIt, typename Gen>
+void shuffle ( RandomIt first_, RandomIt last_, Gen & rng_ );
+
+namespace shuffle_detail {
+
+// Ranges of more than this number of bytes are scattered into buckets first.
+inline constexpr std::size_t cache_size = std::size_t{ 1 } << 21;
+
+// A uniform 64-bit word, from any generator.
+template<typename Gen>
+[[nodiscard]] std::uint64_t word ( Gen & rng_ ) {
+    if constexpr ( std::is_same<typename Gen::result_type, std::uint64_t>::value and Gen::min ( ) == 0u and
+                   Gen::max ( ) == std::numeric_limits<std::uint64_t>::max ( ) )
+        return rng_ ( );
+    else
+        return uniform_int_distribution<std::uint64_t> { } ( rng_ );
+}
+
+// A double in ( 0, 1 ).
+template<typename Gen>
+[[nodiscard]] double open_unit ( Gen & rng_ ) {
+    return ( static_cast<double> ( word ( rng_ ) >> 11 ) + 0.5 ) * 0x1.0p-53;
+}
+
+// A uniform int in [ 0, range_ ), range_ > 0, the modulo is only taken if the draw might be rejected.
+template<typename Gen>
+[[nodiscard]] std::uint64_t bounded ( Gen & rng_, std::uint64_t range_ ) {
+    std::uint64_t l, h = detail::multiply_64 ( word ( rng_ ), range_, l );
+    if ( l < range_ ) {
+        std::uint64_t const threshold = ( 0u - range_ ) % range_;
+        while ( l < threshold )
+            h = detail::multiply_64 ( word ( rng_ ), range_, l );
+    }
+    return h;
+}
+
+// Two independent uniform ints in [ 0, range1_ ) and [ 0, range2_ ), from one word, range1_ * range2_ < 2 ^ 64.
+template<typename Gen>
+[[nodiscard]] std::pair<std::uint64_t, std::uint64_t> bounded_2 ( Gen & rng_, std::uint64_t range1_, std::uint64_t range2_ ) {
+    std::uint64_t l, h1 = detail::multiply_64 ( word ( rng_ ), range1_, l );
+    std::uint64_t h2          = detail::multiply_64 ( l, range2_, l );
+    std::uint64_t const bound = range1_ * range2_;
+    if ( l < bound ) {
+        std::uint64_t const threshold = ( 0u - bound ) % bound;
+        while ( l < threshold ) {
+            h1 = detail::multiply_64 ( word ( rng_ ), range1_, l );
+            h2 = detail::multiply_64 ( l, range2_, l );
+        }
+    }
+    return { h1, h2 };
+}
+
+template<typename RandomIt, typename Gen>
+void fisher_yates ( RandomIt first_, std::uint64_t n_, Gen & rng_ ) {
+    using std::swap;
+    std::uint64_t i = n_;
+    for ( ; i > ( std::uint64_t{ 1 } << 30 ); --i )
+        swap ( first_[ i - 1 ], first_[ bounded ( rng_, i ) ] );
+    for ( ; i > 1u; i -= 2u ) {
+        auto const [ a, b ] = bounded_2 ( rng_, i, i - 1u );
+        swap ( first_[ i - 1 ], first_[ a ] );
+        swap ( first_[ i - 2 ], first_[ b ] );
+    }
+}
+
+// Rao-Sandelius: the elements are scattered into 256 buckets, chosen uniformly and independently, the buckets (which
+// now fit the cache) are shuffled on their own. The bucket of each element is drawn twice from the same sequence, from a
+// copy of the generator, to count and to scatter, so no labels are stored, the scatter goes through a buffer of n_
+// elements. Requires a copyable Gen and a default constructible, copy assignable value_type. Returns false, without
+// drawing from rng_, if the buffer can't be allocated.
+template<typename RandomIt, typename Gen>
+[[nodiscard]] bool scatter_shuffle ( RandomIt first_, std::uint64_t n_, Gen & rng_ ) {
+    using value_type = typename std::iterator_traits<RandomIt>::value_type;
+    static_assert ( std::is_copy_constructible<Gen>::value, "the labels are replayed from a copy of the generator" );
+    static_assert ( std::is_default_constructible<value_type>::value and std::is_copy_assignable<value_type>::value,
+                    "the elements are scattered through a buffer" );
+    constexpr std::size_t bucket_count = 256u;
+    constexpr int labels_per_word      = 8;
+    std::unique_ptr<value_type[]> buffer ( new ( std::nothrow ) value_type[ n_ ] );
+    if ( not buffer )
+        return false;
+    std::uint64_t offsets[ bucket_count + 1 ] = { };
+    Gen replay                                = rng_; // Replays the labels.
+    for ( std::uint64_t i = 0u; i < n_; i += labels_per_word ) {
+        std::uint64_t labels = word ( rng_ );
+        for ( std::uint64_t k = 0u, e = std::min<std::uint64_t> ( labels_per_word, n_ - i ); k < e; ++k, labels >>= 8 )
+            ++offsets[ ( labels & ( bucket_count - 1u ) ) + 1u ];
+    }
+    for ( std::size_t b = 1u; b <= bucket_count; ++b )
+        offsets[ b ] += offsets[ b - 1u ];
+    std::uint64_t ends[ bucket_count ];
+    std::copy ( offsets, offsets + bucket_count, ends );
+    for ( std::uint64_t i = 0u; i < n_; i += labels_per_word ) {
+        std::uint64_t labels = word ( replay );
+        for ( std::uint64_t k = 0u, e = std::min<std::uint64_t> ( labels_per_word, n_ - i ); k < e; ++k, labels >>= 8 )
+            buffer[ ends[ labels & ( bucket_count - 1u ) ]++ ] = first_[ i + k ];
+    }
+    for ( std::size_t b = 0u; b < bucket_count; ++b ) {
+        std::copy ( buffer.get ( ) + offsets[ b ], buffer.get ( ) + offsets[ b + 1u ], first_ + offsets[ b ] );
+        ::sax::shuffle ( first_ + offsets[ b ], first_ + offsets[ b + 1u ], rng_ );
+    }
+    return true;
+}
+
+} // namespace shuffle_detail
+
+template<typename RandomIt, typename Gen>
+void shuffle ( RandomIt first_, RandomIt last_, Gen & rng_ ) {
+    using value_type      = typename std::iterator_traits<RandomIt>::value_type;
+    std::uint64_t const n = static_cast<std::uint64_t> ( last_ - first_ );
+    // Otherwise (or if the buffer can't be allocated) in place.
+    if constexpr ( std::is_trivial<value_type>::value and std::is_copy_constructible<Gen>::value ) {
+        if ( n * sizeof ( value_type ) > shuffle_detail::cache_size and shuffle_detail::scatter_shuffle ( first_, n, rng_ ) )
+            return;
+    }
+    shuffle_detail::fisher_yates ( first_, n, rng_ );
+}
+
+// Copies k_ elements, sampled without replacement, of [ first_, last_ ) to out_, returns the end of the output. For
+// forward iterators the sample keeps the order of the population, for input iterators out_ must be random access.
+template<typename PopulationIt, typename SampleIt, typename Gen>
+SampleIt sample ( PopulationIt first_, PopulationIt last_, std::size_t k_, SampleIt out_, Gen & rng_ ) {
+    using category = typename std::iterator_traits<PopulationIt>::iterator_category;
+    if constexpr ( std::is_base_of<std::forward_iterator_tag, category>::value ) {
+        std::uint64_t n = static_cast<std::uint64_t> ( std::distance ( first_, last_ ) );
+        if ( k_ >= n )
+            return std::copy ( first_, last_, out_ );
+        if constexpr ( std::is_base_of<std::random_access_iterator_tag, category>::value ) {
+            if ( 8u * k_ <= n ) { // Floyd.
+                std::unordered_set<std::uint64_t> selected ( 2u * k_ );
+                std::vector<std::uint64_t> indices;
+                indices.reserve ( k_ );
+                for ( std::uint64_t j = n - k_; j < n; ++j ) {
+                    std::uint64_t t = shuffle_detail::bounded ( rng_, j + 1u );
+                    if ( not selected.insert ( t ).second ) {
+                        selected.insert ( j );
+                        t = j;
+                    }
+                    indices.push_back ( t );
+                }
+                std::sort ( std::begin ( indices ), std::end ( indices ) );
+                for ( std::uint64_t i : indices )
+                    *out_++ = first_[ i ];
+                return out_;
+            }
+        }
+        // Vitter's algorithm A, one random number per selected element.
+        double top = static_cast<double> ( n - k_ ), size = static_cast<double> ( n );
+        for ( ; k_ > 1u; --k_, --n, size -= 1.0 ) {
+            double const v = shuffle_detail::open_unit ( rng_ );
+            double quot    = top / size;
+            while ( quot > v ) {
+                ++first_;
+                --n;
+                top -= 1.0;
+                size -= 1.0;
+                quot *= top / size;
+            }
+            *out_++ = *first_++;
+        }
+        if ( k_ ) {
+            std::advance ( first_, shuffle_detail::bounded ( rng_, n ) );
+            *out_++ = *first_;
+        }
+        return out_;
+    }
+    else { // Reservoir, Li's algorithm L.
+        std::size_t size = 0u;
+        for ( ; size < k_ and first_ != last_; ++first_, ++size )
+            out_[ size ] = *first_;
+        if ( size < k_ )
+            return out_ + size;
+        double w = std::exp ( std::log ( shuffle_detail::open_unit ( rng_ ) ) / static_cast<double> ( k_ ) );
+        for ( ;; ) {
+            double skip = std::floor ( std::log ( shuffle_detail::open_unit ( rng_ ) ) / std::log1p ( -w ) );
+            for ( ; skip > 0.0 and first_ != last_; skip -= 1.0 )
+                ++first_;
+            if ( first_ == last_ )
+                break;
+            out_[ shuffle_detail::bounded ( rng_, k_ ) ] = *first_++;
+            w *= std::exp ( std::log ( shuffle_detail::open_unit ( rng_ ) ) / static_cast<double> ( k_ ) );
+        }
+        return out_ + k_;
+    }
+}
+
+} // namespace sax
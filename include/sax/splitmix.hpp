@@ -38,6 +38,7 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include <cstddef>
 #include <cstdint>
 
 
@@ -155,6 +156,20 @@ template <uint64_t m1, uint64_t m2,
             }
         }
 
+        void generate ( result_type * out, std::size_t n ) {
+            // The seeds are independent, seed_ + i * gamma_, which allows the mixes to overlap.
+            uint64_t seed = seed_;
+            for ( ; n >= 4; n -= 4, out += 4, seed += 4 * gamma_ ) {
+                out[ 0 ] = mix64 ( seed );
+                out[ 1 ] = mix64 ( seed + gamma_ );
+                out[ 2 ] = mix64 ( seed + 2 * gamma_ );
+                out[ 3 ] = mix64 ( seed + 3 * gamma_ );
+            }
+            for ( ; n; --n, seed += gamma_ )
+                *out++ = mix64 ( seed );
+            seed_ = seed;
+        }
+
         void seed ( const result_type s_ ) noexcept { // degski: added this function.
             seed_ = s_;
         }
@@ -196,8 +211,8 @@ template <uint64_t m5, uint64_t m6, unsigned int v, unsigned int w,
 
         using splitmix::splitmix;
 
-        result_type operator()( ) {
-            uint64_t seed = splitmix::next_seed ( );
+        private:
+        static inline constexpr result_type mix32 ( uint64_t seed ) {
             seed ^= seed >> v;
             seed *= m5;
             seed ^= seed >> w;
@@ -205,6 +220,33 @@ template <uint64_t m5, uint64_t m6, unsigned int v, unsigned int w,
             return result_type ( seed >> 32 );
         }
 
+        public:
+
+        result_type operator()( ) {
+            return mix32 ( splitmix::next_seed ( ) );
+        }
+
+        template<typename It>
+        void generate ( It it, const It end ) {
+            while ( it != end ) {
+                *it++ = mix32 ( splitmix::next_seed ( ) );
+            }
+        }
+
+        void generate ( result_type * out, std::size_t n ) {
+            uint64_t seed = splitmix::seed_;
+            uint64_t const gamma = splitmix::gamma_;
+            for ( ; n >= 4; n -= 4, out += 4, seed += 4 * gamma ) {
+                out[ 0 ] = mix32 ( seed );
+                out[ 1 ] = mix32 ( seed + gamma );
+                out[ 2 ] = mix32 ( seed + 2 * gamma );
+                out[ 3 ] = mix32 ( seed + 3 * gamma );
+            }
+            for ( ; n; --n, seed += gamma )
+                *out++ = mix32 ( seed );
+            splitmix::seed_ = seed;
+        }
+
         splitmix32_base split ( ) {
             return splitmix::split ( );
         }
@@ -23,37 +23,490 @@
 
 #pragma once
 
-#define _AMD64_ // For SRWLock...
-#include <windef.h>
-#include <WinBase.h>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
 
+#include <algorithm>
 #include <atomic>
+#include <functional>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#if defined ( _WIN32 )
+#    define _AMD64_ // For SRWLock...
+#    include <windef.h>
+#    include <WinBase.h>
+#elif defined ( __linux__ )
+#    include <climits>
+#    include <sched.h>
+#    include <linux/futex.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#else
+#    error SRWLock is only available on Windows and Linux
+#endif
+
+#if defined ( _MSC_VER ) and not defined ( __clang__ )
+#    include <intrin.h>
+#endif
+#if defined ( __x86_64__ ) or defined ( __i386__ ) or defined ( _M_X64 ) or defined ( _M_IX86 )
+#    include <immintrin.h>
+#endif
 
 
 namespace sax {
 
-struct SpinLock {
+namespace detail {
+
+// Hint to the cpu we're spinning (PAUSE on x86), releases resources to the sibling hyper-thread.
+inline void cpu_relax ( ) noexcept {
+#if defined ( __x86_64__ ) or defined ( __i386__ ) or defined ( _M_X64 ) or defined ( _M_IX86 )
+    _mm_pause ( );
+#elif defined ( __aarch64__ )
+    asm volatile ( "yield" ::: "memory" );
+#endif
+}
+
+// The index of the lowest set bit, m_ > 0.
+[[ nodiscard ]] inline int lowest_bit ( std::uint32_t const m_ ) noexcept {
+#if defined ( _MSC_VER ) and not defined ( __clang__ )
+    unsigned long i;
+    _BitScanForward ( & i, m_ );
+    return static_cast<int> ( i );
+#else
+    return __builtin_ctz ( m_ );
+#endif
+}
+
+// Pauses for 2 ^ round_ PAUSE's, but not more than max_pauses_.
+inline void backoff ( int const round_, int const max_pauses_ ) noexcept {
+    int const n = round_ < 30 ? std::min ( 1 << round_, max_pauses_ ) : max_pauses_;
+    for ( int i = 0; i < n; ++i )
+        cpu_relax ( );
+}
+
+#if defined ( __linux__ )
+inline constexpr bool has_futex = true;
+
+// Sleeps as long as word_ equals expected_ (or until woken spuriously).
+inline void futex_wait ( std::atomic<std::uint32_t> & word_, std::uint32_t const expected_ ) noexcept {
+    static_assert ( sizeof ( std::atomic<std::uint32_t> ) == sizeof ( std::uint32_t ), "futex word must be 32 bits" );
+    syscall ( SYS_futex, reinterpret_cast<std::uint32_t *> ( & word_ ), FUTEX_WAIT_PRIVATE, expected_, nullptr, nullptr, 0 );
+}
+inline void futex_wake_one ( std::atomic<std::uint32_t> & word_ ) noexcept {
+    syscall ( SYS_futex, reinterpret_cast<std::uint32_t *> ( & word_ ), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0 );
+}
+inline void futex_wake_all ( std::atomic<std::uint32_t> & word_ ) noexcept {
+    syscall ( SYS_futex, reinterpret_cast<std::uint32_t *> ( & word_ ), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0 );
+}
+#else
+inline constexpr bool has_futex = false;
+
+// Never called, allows for if constexpr'ed code to compile.
+inline void futex_wait ( std::atomic<std::uint32_t> &, std::uint32_t const ) noexcept { }
+inline void futex_wake_one ( std::atomic<std::uint32_t> & ) noexcept { }
+#endif
+
+} // namespace detail
+
+namespace spin_policy {
+
+// Spins on a relaxed load, backing off exponentially (in PAUSE's), never gives up the cpu.
+struct backoff {
+    static constexpr int max_pauses  = 64;
+    static constexpr int spin_rounds = std::numeric_limits<int>::max ( );
+    static constexpr bool parks      = false;
+};
+
+// As backoff, yields the time-slice once the spin budget is exhausted.
+struct yield {
+    static constexpr int max_pauses  = 64;
+    static constexpr int spin_rounds = 16;
+    static constexpr bool parks      = false;
+};
+
+// As backoff, parks the thread on a futex once the spin budget is exhausted (yields where futexes are not available).
+struct park {
+    static constexpr int max_pauses  = 64;
+    static constexpr int spin_rounds = 16;
+    static constexpr bool parks      = true;
+};
+
+} // namespace spin_policy
+
+// Test-and-test-and-set spin-lock, the contention behaviour is chosen with the Policy (see spin_policy).
+template<typename Policy = spin_policy::backoff>
+struct basic_spin_lock {
+
+    basic_spin_lock ( ) noexcept { }
+    basic_spin_lock ( const basic_spin_lock & ) = delete;
+    basic_spin_lock & operator = ( const basic_spin_lock & ) = delete;
+
+    void lock ( ) noexcept {
+        std::uint32_t s = unlocked;
+        if ( m_word.compare_exchange_weak ( s, locked, std::memory_order_acquire, std::memory_order_relaxed ) )
+            return;
+        lock_contended ( );
+    }
+    [[ nodiscard ]] bool try_lock ( ) noexcept {
+        std::uint32_t s = m_word.load ( std::memory_order_relaxed );
+        return unlocked == s and m_word.compare_exchange_strong ( s, locked, std::memory_order_acquire, std::memory_order_relaxed );
+    }
+    void unlock ( ) noexcept {
+        if constexpr ( parks ) {
+            if ( contended == m_word.exchange ( unlocked, std::memory_order_release ) )
+                detail::futex_wake_one ( m_word );
+        }
+        else {
+            m_word.store ( unlocked, std::memory_order_release );
+        }
+    }
+
+    private:
+
+    static constexpr std::uint32_t unlocked  = 0u;
+    static constexpr std::uint32_t locked    = 1u;
+    static constexpr std::uint32_t contended = 2u; // Locked, with (possibly) threads parked on the futex.
+
+    static constexpr bool parks = Policy::parks and detail::has_futex;
+
+    void lock_contended ( ) noexcept {
+        // Once parked, we can no longer tell whether there are other sleepers, so we acquire as contended (Drepper).
+        std::uint32_t acquired = locked;
+        int round = 0;
+        while ( true ) {
+            std::uint32_t s = m_word.load ( std::memory_order_relaxed );
+            if ( unlocked == s ) {
+                if ( m_word.compare_exchange_weak ( s, acquired, std::memory_order_acquire, std::memory_order_relaxed ) )
+                    return;
+                continue;
+            }
+            if ( round < Policy::spin_rounds ) {
+                detail::backoff ( round++, Policy::max_pauses );
+                continue;
+            }
+            if constexpr ( parks ) {
+                if ( unlocked == m_word.exchange ( contended, std::memory_order_acquire ) )
+                    return;
+                detail::futex_wait ( m_word, contended );
+                acquired = contended;
+            }
+            else {
+                std::this_thread::yield ( );
+            }
+        }
+    }
+
+    alignas ( 64 ) std::atomic<std::uint32_t> m_word = { unlocked };
+};
+
+using SpinLock = basic_spin_lock<spin_policy::backoff>;
+
 
-    SpinLock ( ) noexcept { }
-    SpinLock ( const SpinLock & ) = delete;
-    SpinLock & operator = ( const SpinLock & ) = delete;
+// Fair (FIFO) ticket-lock, both counters share a cache line. Waiters back off proportionally to their distance to the head of the queue.
+struct TicketLock {
+
+    TicketLock ( ) noexcept { }
+    TicketLock ( const TicketLock & ) = delete;
+    TicketLock & operator = ( const TicketLock & ) = delete;
 
     void lock ( ) noexcept {
-        while ( flag.test_and_set ( std::memory_order_acquire ) );
+        std::uint32_t const ticket = m_next.fetch_add ( 1u, std::memory_order_relaxed );
+        while ( true ) {
+            std::uint32_t const serving = m_serving.load ( std::memory_order_acquire );
+            if ( ticket == serving )
+                return;
+            for ( std::uint32_t i = std::min ( ticket - serving, max_pauses ); i; --i )
+                detail::cpu_relax ( );
+        }
     }
     [[ nodiscard ]] bool try_lock ( ) noexcept {
-        return not ( flag.test_and_set ( std::memory_order_acquire ) );
+        std::uint32_t ticket = m_serving.load ( std::memory_order_acquire );
+        return m_next.compare_exchange_strong ( ticket, ticket + 1u, std::memory_order_acquire, std::memory_order_relaxed );
     }
     void unlock ( ) noexcept {
-        flag.clear ( std::memory_order_release );
+        // Only the owner writes m_serving.
+        m_serving.store ( m_serving.load ( std::memory_order_relaxed ) + 1u, std::memory_order_release );
     }
 
     private:
 
-    alignas ( 64 ) std::atomic_flag flag = ATOMIC_FLAG_INIT;
+    static constexpr std::uint32_t max_pauses = 64u;
+
+    alignas ( 64 ) std::atomic<std::uint32_t> m_next = { 0u };
+    std::atomic<std::uint32_t> m_serving             = { 0u };
 };
 
 
+// Mellor-Crummey and Scott queue-lock, each waiter spins on its own node, a hand-off touches one remote cache line only.
+// The lock ( node & ) interface is the canonical one, lock ( ) takes a node from a small thread-local pool, making the
+// lock a drop-in for std::lock_guard (a thread can hold up to 32 MCSLock's simultaneously).
+struct MCSLock {
+
+    struct node {
+        std::atomic<node *> next = { nullptr };
+        std::atomic<bool> locked = { false };
+    };
+
+    MCSLock ( ) noexcept { }
+    MCSLock ( const MCSLock & ) = delete;
+    MCSLock & operator = ( const MCSLock & ) = delete;
+
+    void lock ( node & node_ ) noexcept {
+        node_.next.store ( nullptr, std::memory_order_relaxed );
+        node_.locked.store ( true, std::memory_order_relaxed );
+        if ( node * const pred = m_tail.exchange ( & node_, std::memory_order_acq_rel ); pred ) {
+            pred->next.store ( & node_, std::memory_order_release );
+            while ( node_.locked.load ( std::memory_order_acquire ) )
+                detail::cpu_relax ( );
+        }
+    }
+    [[ nodiscard ]] bool try_lock ( node & node_ ) noexcept {
+        node_.next.store ( nullptr, std::memory_order_relaxed );
+        node * expected = nullptr;
+        return m_tail.compare_exchange_strong ( expected, & node_, std::memory_order_acquire, std::memory_order_relaxed );
+    }
+    void unlock ( node & node_ ) noexcept {
+        node * succ = node_.next.load ( std::memory_order_acquire );
+        if ( not succ ) {
+            node * expected = & node_;
+            if ( m_tail.compare_exchange_strong ( expected, nullptr, std::memory_order_release, std::memory_order_relaxed ) )
+                return;
+            // A successor is linking itself in.
+            while ( not ( succ = node_.next.load ( std::memory_order_acquire ) ) )
+                detail::cpu_relax ( );
+        }
+        succ->locked.store ( false, std::memory_order_release );
+    }
+
+    void lock ( ) noexcept {
+        node & n = local_nodes ( ).acquire ( );
+        lock ( n );
+        m_owner = & n;
+    }
+    [[ nodiscard ]] bool try_lock ( ) noexcept {
+        node & n = local_nodes ( ).acquire ( );
+        if ( try_lock ( n ) ) {
+            m_owner = & n;
+            return true;
+        }
+        local_nodes ( ).release ( n );
+        return false;
+    }
+    void unlock ( ) noexcept {
+        node * const n = m_owner; // Protected by the lock itself.
+        unlock ( *n );
+        local_nodes ( ).release ( *n );
+    }
+
+    private:
+
+    struct node_pool {
+        alignas ( 64 ) node nodes [ 32 ];
+        std::uint32_t used = 0u;
+
+        [[ nodiscard ]] node & acquire ( ) noexcept {
+            assert ( ~used and "more than 32 MCSLock's held by this thread" );
+            int const i = detail::lowest_bit ( ~used );
+            used |= std::uint32_t { 1 } << i;
+            return nodes [ i ];
+        }
+        void release ( node & node_ ) noexcept {
+            used &= ~( std::uint32_t { 1 } << static_cast<int> ( & node_ - nodes ) );
+        }
+    };
+
+    [[ nodiscard ]] static node_pool & local_nodes ( ) noexcept {
+        static thread_local node_pool pool;
+        return pool;
+    }
+
+    alignas ( 64 ) std::atomic<node *> m_tail = { nullptr };
+    node * m_owner                            = nullptr;
+};
+
+
+// Reader-writer lock with one (cache-line) reader slot per shard, readers only touch the slot of their thread, writers
+// acquire all shards. Threads are assigned a slot on first use (from the cpu they're running on, or from a hash of
+// their id), a slot is shared by all threads mapping onto it. Read-locking is cheap, write-locking is O(Shards).
+template<std::size_t Shards = 64>
+struct sharded_rw_lock {
+
+    static_assert ( Shards > 0, "at least one shard is required" );
+
+    sharded_rw_lock ( ) noexcept { }
+    sharded_rw_lock ( const sharded_rw_lock & ) = delete;
+    sharded_rw_lock & operator = ( const sharded_rw_lock & ) = delete;
+
+    void lock ( ) noexcept {
+        int round = 0;
+        while ( m_writer.exchange ( true, std::memory_order_seq_cst ) )
+            wait ( round );
+        for ( shard & s : m_shards )
+            while ( s.readers.load ( std::memory_order_seq_cst ) )
+                wait ( round );
+    }
+    [[ nodiscard ]] bool try_lock ( ) noexcept {
+        if ( m_writer.exchange ( true, std::memory_order_seq_cst ) )
+            return false;
+        for ( shard & s : m_shards ) {
+            if ( s.readers.load ( std::memory_order_seq_cst ) ) {
+                m_writer.store ( false, std::memory_order_release );
+                return false;
+            }
+        }
+        return true;
+    }
+    void unlock ( ) noexcept { m_writer.store ( false, std::memory_order_release ); }
+
+    void lock_read ( ) noexcept {
+        shard & s = m_shards [ local_shard ( ) ];
+        int round = 0;
+        while ( true ) {
+            s.readers.fetch_add ( 1u, std::memory_order_seq_cst );
+            if ( not m_writer.load ( std::memory_order_seq_cst ) )
+                return;
+            s.readers.fetch_sub ( 1u, std::memory_order_relaxed );
+            while ( m_writer.load ( std::memory_order_relaxed ) )
+                wait ( round );
+        }
+    }
+    [[ nodiscard ]] bool try_lock_read ( ) noexcept {
+        shard & s = m_shards [ local_shard ( ) ];
+        s.readers.fetch_add ( 1u, std::memory_order_seq_cst );
+        if ( not m_writer.load ( std::memory_order_seq_cst ) )
+            return true;
+        s.readers.fetch_sub ( 1u, std::memory_order_relaxed );
+        return false;
+    }
+    void unlock_read ( ) noexcept { m_shards [ local_shard ( ) ].readers.fetch_sub ( 1u, std::memory_order_release ); }
+
+    private:
+
+    struct alignas ( 64 ) shard {
+        std::atomic<std::uint32_t> readers = { 0u };
+    };
+
+    // The slot is fixed per thread (not per cpu), as the thread might migrate while holding the lock.
+    [[ nodiscard ]] static std::size_t local_shard ( ) noexcept {
+        static thread_local std::size_t const index = [ ] {
+#if defined ( __linux__ )
+            if ( int const cpu = sched_getcpu ( ); cpu >= 0 )
+                return static_cast<std::size_t> ( cpu );
+#endif
+            return std::hash<std::thread::id> { } ( std::this_thread::get_id ( ) );
+        }( ) % Shards;
+        return index;
+    }
+
+    static void wait ( int & round_ ) noexcept {
+        if ( round_ < 16 )
+            detail::backoff ( round_++, 64 );
+        else
+            std::this_thread::yield ( );
+    }
+
+    alignas ( 64 ) std::atomic<bool> m_writer = { false };
+    shard m_shards [ Shards ];
+};
+
+
+namespace detail {
+template<typename T>
+using is_valid_seq_lock_type =
+    std::enable_if_t<std::conjunction<std::is_default_constructible<T>, std::is_trivially_copyable<T>>::value, T>;
+}
+
+// Sequence-lock guarding a snapshot of a T, readers never write to shared memory and retry iff a write overlapped
+// the read. Writers are serialized on the sequence word. T is held in relaxed atomic words (Boehm), which makes
+// the racy read well-defined.
+template<typename T, typename = detail::is_valid_seq_lock_type<T>>
+struct SeqLock {
+
+    using value_type = T;
+
+    SeqLock ( ) noexcept : SeqLock ( T { } ) { }
+    explicit SeqLock ( T const & value_ ) noexcept { write_words ( value_ ); }
+    SeqLock ( const SeqLock & ) = delete;
+    SeqLock & operator = ( const SeqLock & ) = delete;
+
+    [[ nodiscard ]] T load ( ) const noexcept {
+        T value;
+        while ( not try_load ( value ) )
+            detail::cpu_relax ( );
+        return value;
+    }
+    // Returns false (and leaves value_ in an unspecified state) iff a writer interfered.
+    [[ nodiscard ]] bool try_load ( T & value_ ) const noexcept {
+        std::uint32_t const s = m_seq.load ( std::memory_order_acquire );
+        if ( s & 1u )
+            return false;
+        read_words ( value_ );
+        std::atomic_thread_fence ( std::memory_order_acquire );
+        return m_seq.load ( std::memory_order_relaxed ) == s;
+    }
+
+    void store ( T const & value_ ) noexcept {
+        std::uint32_t const s = begin_write ( );
+        write_words ( value_ );
+        m_seq.store ( s + 2u, std::memory_order_release );
+    }
+    // Read-modify-write of the snapshot, f_ is called with a T &.
+    template<typename Function>
+    void update ( Function f_ ) noexcept ( noexcept ( f_ ( std::declval<T &> ( ) ) ) ) {
+        // Ends the write on unwinding as well (if f_ throws, the snapshot is left unchanged), an odd sequence would
+        // block all readers and writers forever.
+        struct end_write {
+            std::atomic<std::uint32_t> & seq;
+            std::uint32_t const s;
+            ~end_write ( ) { seq.store ( s + 2u, std::memory_order_release ); }
+        } const guard { m_seq, begin_write ( ) };
+        T value;
+        read_words ( value );
+        f_ ( value );
+        write_words ( value );
+    }
+
+    private:
+
+    static constexpr std::size_t word_count = ( sizeof ( T ) + sizeof ( std::uint64_t ) - 1 ) / sizeof ( std::uint64_t );
+
+    // Returns the (even) sequence number before the write, the sequence is odd on return. Taking the sequence acquires
+    // (it synchronizes with the release of the previous writer, whose words update ( ) reads), the release fence
+    // keeps the word stores after the odd sequence.
+    [[ nodiscard ]] std::uint32_t begin_write ( ) noexcept {
+        std::uint32_t s = m_seq.load ( std::memory_order_relaxed );
+        while ( ( s & 1u ) or not m_seq.compare_exchange_weak ( s, s + 1u, std::memory_order_acquire, std::memory_order_relaxed ) ) {
+            detail::cpu_relax ( );
+            s = m_seq.load ( std::memory_order_relaxed );
+        }
+        std::atomic_thread_fence ( std::memory_order_release );
+        return s;
+    }
+
+    void read_words ( T & value_ ) const noexcept {
+        std::uint64_t words [ word_count ];
+        for ( std::size_t i = 0; i < word_count; ++i )
+            words [ i ] = m_data [ i ].load ( std::memory_order_relaxed );
+        std::memcpy ( & value_, words, sizeof ( T ) );
+    }
+    void write_words ( T const & value_ ) noexcept {
+        std::uint64_t words [ word_count ] = { };
+        std::memcpy ( words, & value_, sizeof ( T ) );
+        for ( std::size_t i = 0; i < word_count; ++i )
+            m_data [ i ].store ( words [ i ], std::memory_order_relaxed );
+    }
+
+    alignas ( 64 ) std::atomic<std::uint32_t> m_seq = { 0u };
+    std::atomic<std::uint64_t> m_data [ word_count ];
+};
+
+
+#if defined ( _WIN32 )
+
 struct SRWLock {
 
     SRWLock ( ) noexcept { }
@@ -85,4 +538,125 @@ struct SRWLock {
     alignas ( 64 ) SRWLOCK m_handle = SRWLOCK_INIT;
 };
 
+#else
+
+// A reader-writer lock on a single 32-bit futex word, the layout of the word is:
+//
+//   bit 31:      a writer holds the lock,
+//   bit 30:      there are threads parked on the futex,
+//   bits 18-29:  the number of writers waiting, while non-zero new readers back off (writer preference),
+//   bits 0-17:   the number of readers holding the lock.
+//
+// Contended acquisition spins for a while before parking the thread with FUTEX_WAIT.
+struct SRWLock {
+
+    SRWLock ( ) noexcept { }
+    SRWLock ( const SRWLock & ) = delete;
+    SRWLock & operator = ( const SRWLock & ) = delete;
+
+    void lock ( ) noexcept {
+        std::uint32_t s = m_state.load ( std::memory_order_relaxed );
+        if ( not ( s & ( writer | reader_mask ) ) and m_state.compare_exchange_weak ( s, s | writer, std::memory_order_acquire, std::memory_order_relaxed ) )
+            return;
+        lock_contended ( );
+    }
+    [[ nodiscard ]] bool try_lock ( ) noexcept {
+        std::uint32_t s = m_state.load ( std::memory_order_relaxed );
+        return not ( s & ( writer | reader_mask ) ) and m_state.compare_exchange_strong ( s, s | writer, std::memory_order_acquire, std::memory_order_relaxed );
+    }
+    void unlock ( ) noexcept {
+        // Clears the writer and parked bits only, the count of the writers still waiting must survive.
+        if ( m_state.fetch_and ( ~( writer | parked ), std::memory_order_release ) & parked )
+            detail::futex_wake_all ( m_state );
+    }
+
+    void lock_read ( ) noexcept {
+        std::uint32_t s = m_state.load ( std::memory_order_relaxed );
+        if ( not ( s & ( writer | writers_mask ) ) and m_state.compare_exchange_weak ( s, s + 1u, std::memory_order_acquire, std::memory_order_relaxed ) )
+            return;
+        lock_read_contended ( );
+    }
+    [[ nodiscard ]] bool try_lock_read ( ) noexcept {
+        std::uint32_t s = m_state.load ( std::memory_order_relaxed );
+        while ( not ( s & ( writer | writers_mask ) ) ) {
+            assert ( ( s & reader_mask ) != reader_mask );
+            if ( m_state.compare_exchange_weak ( s, s + 1u, std::memory_order_acquire, std::memory_order_relaxed ) )
+                return true;
+        }
+        return false;
+    }
+    void unlock_read ( ) noexcept {
+        std::uint32_t const s = m_state.fetch_sub ( 1u, std::memory_order_release ) - 1u;
+        // The last reader out wakes the parked (writers).
+        if ( not ( s & reader_mask ) and ( s & parked ) ) {
+            m_state.fetch_and ( ~parked, std::memory_order_relaxed );
+            detail::futex_wake_all ( m_state );
+        }
+    }
+
+    private:
+
+    static constexpr std::uint32_t writer       = std::uint32_t { 1 } << 31;
+    static constexpr std::uint32_t parked       = std::uint32_t { 1 } << 30;
+    static constexpr std::uint32_t writer_one   = std::uint32_t { 1 } << 18; // One waiting writer.
+    static constexpr std::uint32_t writers_mask = parked - writer_one;
+    static constexpr std::uint32_t reader_mask  = writer_one - 1u;
+
+    static constexpr int spin_count = 128;
+
+    void lock_contended ( ) noexcept {
+        // Announce ourselves, stopping new readers from coming in, until the last waiting writer got the lock.
+        std::uint32_t s = m_state.fetch_add ( writer_one, std::memory_order_relaxed );
+        assert ( ( s & writers_mask ) != writers_mask );
+        s += writer_one;
+        int spin = 0;
+        while ( true ) {
+            if ( not ( s & ( writer | reader_mask ) ) ) {
+                if ( m_state.compare_exchange_weak ( s, ( s | writer ) - writer_one, std::memory_order_acquire, std::memory_order_relaxed ) )
+                    return;
+                continue;
+            }
+            if ( spin < spin_count ) {
+                ++spin;
+                detail::cpu_relax ( );
+                s = m_state.load ( std::memory_order_relaxed );
+                continue;
+            }
+            std::uint32_t const t = s | parked;
+            if ( t != s and not m_state.compare_exchange_weak ( s, t, std::memory_order_relaxed, std::memory_order_relaxed ) )
+                continue;
+            detail::futex_wait ( m_state, t );
+            s = m_state.load ( std::memory_order_relaxed );
+        }
+    }
+
+    void lock_read_contended ( ) noexcept {
+        std::uint32_t s = m_state.load ( std::memory_order_relaxed );
+        int spin = 0;
+        while ( true ) {
+            if ( not ( s & ( writer | writers_mask ) ) ) {
+                assert ( ( s & reader_mask ) != reader_mask );
+                if ( m_state.compare_exchange_weak ( s, s + 1u, std::memory_order_acquire, std::memory_order_relaxed ) )
+                    return;
+                continue;
+            }
+            if ( spin < spin_count ) {
+                ++spin;
+                detail::cpu_relax ( );
+                s = m_state.load ( std::memory_order_relaxed );
+                continue;
+            }
+            std::uint32_t const t = s | parked;
+            if ( t != s and not m_state.compare_exchange_weak ( s, t, std::memory_order_relaxed, std::memory_order_relaxed ) )
+                continue;
+            detail::futex_wait ( m_state, t );
+            s = m_state.load ( std::memory_order_relaxed );
+        }
+    }
+
+    alignas ( 64 ) std::atomic<std::uint32_t> m_state = { 0u };
+};
+
+#endif
+
 }
@@ -0,0 +1,143 @@
+
+// MIT License
+//
+// Copyright (c) 2020 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include <limits>
+#include <utility>
+
+#include "jsf.hpp"
+#include "sfc.hpp"
+#include "splitmix.hpp"
+
+// Per-thread streams of the chaotic generators (sfc, jsf), which don't allow for cheap jump-ahead, derived from one
+// master seed. stream ( i ) depends on the master seed and the stream count only, i.e. is reproducible.
+//
+// sfc: the counter d_ of stream i starts at i * guaranteed_length ( ), as the full state includes the counter
+//      (which increments by one on every step), no two streams can share a state within their first
+//      guaranteed_length ( ) values, the other words are seeded from splitmix64.
+// jsf: there is no counter, the state of stream i is seeded from the i-th split ( ) of a splitmix64, the streams are
+//      distinct with overwhelming probability, but no guarantee can be given, guaranteed_length ( ) returns 0.
+
+namespace sax {
+
+namespace stream_detail {
+
+template<typename Gen>
+struct stream_traits;
+
+template<typename itype, typename rtype, unsigned int p, unsigned int q, unsigned int r>
+struct stream_traits<sfc_detail::sfc<itype, rtype, p, q, r>> : sfc_detail::sfc<itype, rtype, p, q, r> {
+
+    using generator_type = sfc_detail::sfc<itype, rtype, p, q, r>;
+
+    static constexpr bool has_counter = true;
+    static constexpr int warm_up      = 12;
+
+    // Sets the state directly (the counter is not made odd), and warms up.
+    static generator_type make ( splitmix64 & words_, itype counter_ ) {
+        stream_traits g;
+        g.a_ = static_cast<itype> ( words_ ( ) );
+        g.b_ = static_cast<itype> ( words_ ( ) );
+        g.c_ = static_cast<itype> ( words_ ( ) );
+        g.d_ = counter_;
+        g.discard ( warm_up );
+        return g;
+    }
+};
+
+template<typename itype, typename rtype, unsigned int p, unsigned int q, unsigned int r>
+struct stream_traits<jsf_detail::jsf<itype, rtype, p, q, r>> {
+
+    using generator_type = jsf_detail::jsf<itype, rtype, p, q, r>;
+
+    static constexpr bool has_counter = false;
+
+    static generator_type make ( splitmix64 & words_, itype ) {
+        itype s1 = static_cast<itype> ( words_ ( ) ), s2 = static_cast<itype> ( words_ ( ) ), s3 = static_cast<itype> ( words_ ( ) ),
+              s4 = static_cast<itype> ( words_ ( ) );
+        return generator_type ( std::move ( s1 ), std::move ( s2 ), std::move ( s3 ), std::move ( s4 ) );
+    }
+};
+
+} // namespace stream_detail
+
+template<typename Gen>
+class stream_family {
+
+    using traits     = stream_detail::stream_traits<Gen>;
+    using state_type = typename Gen::state_type;
+
+    static constexpr int STATE_BITS = std::numeric_limits<state_type>::digits;
+
+    std::uint64_t master_seed_;
+    std::size_t stream_count_;
+    int stream_bits_; // The high bits of the counter identifying the stream.
+
+    public:
+    using generator_type = Gen;
+
+    explicit stream_family ( std::uint64_t master_seed, std::size_t stream_count ) :
+        master_seed_ ( master_seed ), stream_count_ ( stream_count ), stream_bits_ ( 0 ) {
+        while ( stream_bits_ < STATE_BITS and ( std::uint64_t{ 1 } << stream_bits_ ) < stream_count )
+            ++stream_bits_;
+        assert ( ( not traits::has_counter or stream_bits_ < STATE_BITS ) and "too many streams for the counter" );
+    }
+
+    [[nodiscard]] std::size_t size ( ) const noexcept { return stream_count_; }
+
+    // The number of values stream ( i ) is guaranteed not to overlap with any other stream, 0 if the counter bits left
+    // to each stream do not even cover the warm-up.
+    [[nodiscard]] std::uint64_t guaranteed_length ( ) const noexcept {
+        if constexpr ( traits::has_counter ) {
+            int const bits           = STATE_BITS - stream_bits_;
+            std::uint64_t const span = bits < 64 ? std::uint64_t{ 1 } << bits : std::numeric_limits<std::uint64_t>::max ( );
+            return span > traits::warm_up ? span - traits::warm_up : 0u;
+        }
+        else {
+            return 0u;
+        }
+    }
+
+    [[nodiscard]] Gen stream ( std::size_t i ) const {
+        assert ( i < stream_count_ );
+        if constexpr ( traits::has_counter ) {
+            splitmix64 words ( master_seed_ );
+            words.advance ( 3u * static_cast<std::uint64_t> ( i ) );
+            int const bits = STATE_BITS - stream_bits_;
+            return traits::make ( words, bits < 64 ? static_cast<state_type> ( static_cast<std::uint64_t> ( i ) << bits ) : state_type{ 0 } );
+        }
+        else {
+            splitmix64 master ( master_seed_ );
+            master.advance ( 2u * static_cast<std::uint64_t> ( i ) ); // split ( ) consumes two values.
+            splitmix64 words = master.split ( );
+            return traits::make ( words, state_type{ 0 } );
+        }
+    }
+};
+
+} // namespace sax
@@ -31,6 +31,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 
 #define M32 ( UINTPTR_MAX == 0xFFFF'FFFF )
 #define M64 ( UINTPTR_MAX == 0xFFFF'FFFF'FFFF'FFFF )
@@ -39,12 +40,16 @@
 #    error funny pointers detected
 #endif
 
+#include <algorithm>
 #include <functional>
 #include <iostream>
+#include <iterator>
 #include <limits>
 #include <random>
 #include <type_traits>
 
+#include "detail/multiply.hpp"
+
 #if defined( _WIN32 ) and not( defined( __clang__ ) or defined( __GNUC__ ) ) // MSVC and not clang or gcc on windows.
 #    include <intrin.h>
 #    ifdef _WIN64
@@ -168,6 +173,14 @@ struct bits_engine<Gen, UnsignedResultType, false> : public generator_reference<
     explicit bits_engine ( Gen & gen ) : generator_reference<Gen> ( gen ) {}
 };
 
+// Gen has a bulk generate ( result_type *, std::size_t ) (all sax generators do).
+template<typename Gen, typename = void>
+struct has_bulk_generate : std::false_type {};
+template<typename Gen>
+struct has_bulk_generate<Gen, std::void_t<decltype ( std::declval<Gen &> ( ).generate (
+                                  std::declval<typename Gen::result_type *> ( ), std::declval<std::size_t> ( ) ) )>>
+    : std::true_type {};
+
 template<typename IT>
 struct double_width_integer {};
 template<>
@@ -276,11 +289,91 @@ class uniform_int_distribution : public detail::param_type<IntType, uniform_int_
         }
     }
 
+    // Fills [ first, last ). A generator with a bulk generate ( ) and an output wider than range_type (f.e. sfc64,
+    // mcg128_fast or sfc64x4 for a 32-bit range) fills blocks from its bulk generate ( ), split into range_type words,
+    // the multiplies are done in a tight loop and only the (rare) rejected values are re-drawn. Otherwise, the generator
+    // is the bottleneck, the values are drawn one by one, as by operator ( ). The values are uniform and independent,
+    // but not the same sequence as repeated calls to operator ( ).
+    template<typename Gen, typename OutputIt>
+    void generate ( Gen & rng, OutputIt first, OutputIt last ) const NOEXCEPT {
+        using gen_result_type = typename Gen::result_type;
+        constexpr bool split  = detail::has_bulk_generate<Gen>::value and Gen::min ( ) == 0 and
+                               Gen::max ( ) == std::numeric_limits<gen_result_type>::max ( ) and
+                               sizeof ( gen_result_type ) > sizeof ( range_type ) and
+                               sizeof ( gen_result_type ) % sizeof ( range_type ) == 0;
+        generator_reference<Gen> rng_ref ( rng );
+        range_type const min = static_cast<range_type> ( pt::min ), range = pt::range, mask = pt::mask;
+        if constexpr ( split ) {
+            constexpr std::size_t words_per_draw = sizeof ( gen_result_type ) / sizeof ( range_type );
+            constexpr std::size_t block_size     = 256u;
+            gen_result_type draws[ block_size / words_per_draw ];
+            range_type words[ block_size ];
+            while ( first != last ) {
+                std::size_t n = 0u;
+                if constexpr ( std::is_same<typename std::iterator_traits<OutputIt>::iterator_category,
+                                            std::random_access_iterator_tag>::value )
+                    n = std::min ( block_size, static_cast<std::size_t> ( last - first ) );
+                else
+                    for ( OutputIt it = first; n < block_size and it != last; ++it )
+                        ++n;
+                rng.generate ( draws, ( n + words_per_draw - 1u ) / words_per_draw );
+                std::memcpy ( words, draws, n * sizeof ( range_type ) );
+                if ( range ) {
+                    range_type rejected = 0u;
+                    for ( std::size_t i = 0u; i < n; ++i ) {
+                        range_type l;
+                        range_type const h = multiply ( words[ i ], range, l );
+                        rejected |= l < mask;
+                        words[ i ] = h;
+                    }
+                    if ( rejected ) { // Redo the block, re-drawing the rejected values.
+                        std::memcpy ( words, draws, n * sizeof ( range_type ) );
+                        for ( std::size_t i = 0u; i < n; ++i ) {
+                            range_type l;
+                            range_type const h = multiply ( words[ i ], range, l );
+                            words[ i ]         = l < mask ? static_cast<range_type> ( bounded_range_lemire ( rng_ref ) ) : h;
+                        }
+                    }
+                }
+                for ( std::size_t i = 0u; i < n; ++i, ++first )
+                    *first = static_cast<result_type> ( static_cast<range_type> ( words[ i ] + min ) );
+            }
+        }
+        else {
+            if ( range )
+                for ( ; first != last; ++first ) {
+                    range_type l, h = multiply ( rng_ref ( ), range, l );
+                    while ( l < mask )
+                        h = multiply ( rng_ref ( ), range, l );
+                    *first = static_cast<result_type> ( static_cast<range_type> ( h + min ) );
+                }
+            else
+                for ( ; first != last; ++first )
+                    *first = static_cast<result_type> ( rng_ref ( ) );
+        }
+    }
+
     [[nodiscard]] param_type param ( ) const NOEXCEPT { return *this; }
 
     void param ( const param_type & params ) NOEXCEPT { *this = params; }
 
     private:
+    // Returns the high half of the full product of x and y, the low half goes to l.
+    [[nodiscard]] static range_type multiply ( range_type x, range_type y, range_type & l ) NOEXCEPT {
+        if constexpr ( sizeof ( range_type ) == sizeof ( std::uint64_t ) ) {
+            std::uint64_t lo      = 0u;
+            std::uint64_t const h = detail::multiply_64 ( x, y, lo );
+            l                     = range_type ( lo );
+            return range_type ( h );
+        }
+        else {
+            using double_width_unsigned_result_type = typename detail::double_width_integer<range_type>::type;
+            double_width_unsigned_result_type const m = double_width_unsigned_result_type ( x ) * double_width_unsigned_result_type ( y );
+            l                                         = range_type ( m );
+            return range_type ( m >> std::numeric_limits<range_type>::digits );
+        }
+    }
+
     template<typename Rng>
     result_type bounded_range_lemire ( Rng & rng ) const NOEXCEPT {
 #if MSVC and M64
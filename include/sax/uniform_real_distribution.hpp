@@ -0,0 +1,201 @@
+
+// MIT License
+//
+// Copyright (c) 2020 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+#include "uniform_int_distribution.hpp"
+
+// Real distributions (this one, and the ziggurat ones in ziggurat.hpp) draw 64-bit words from the generator and only
+// use IEEE basic arithmetic (no libm) on them, their output is therefore the same with any compiler or standard library,
+// given the generator. Products which are added to are rounded on their own, not contracted with the addition into an
+// fma (which rounds once): with gcc (from 12) through real_detail::rounded ( ), with clang through the fp contract
+// pragma, on other compilers (and older gcc's) on targets with fma, compile with -ffp-contract=off.
+
+#if defined( __clang__ )
+#pragma float_control( push )
+#pragma clang fp contract( off )
+#endif
+
+namespace sax {
+
+namespace real_detail {
+
+// x_, not contracted with the operation it is an operand of.
+template<typename RealType>
+[[nodiscard]] constexpr RealType rounded ( RealType x_ ) noexcept {
+#if defined( __GNUC__ ) and not defined( __clang__ ) and __GNUC__ >= 12
+    return __builtin_assoc_barrier ( x_ );
+#else
+    return x_;
+#endif
+}
+
+template<typename Gen>
+inline constexpr bool is_word_generator = std::is_same<typename Gen::result_type, std::uint64_t>::value and
+                                          Gen::min ( ) == 0u and Gen::max ( ) == std::numeric_limits<std::uint64_t>::max ( );
+
+// A uniform 64-bit word, from any generator.
+template<typename Gen>
+[[nodiscard]] std::uint64_t word ( Gen & rng_ ) {
+    if constexpr ( is_word_generator<Gen> )
+        return rng_ ( );
+    else
+        return uniform_int_distribution<std::uint64_t> { } ( rng_ );
+}
+
+// n_ uniform 64-bit words, with the bulk generate ( ) of the generator, if it has one.
+template<typename Gen>
+void words ( Gen & rng_, std::uint64_t * out_, std::size_t n_ ) {
+    if constexpr ( is_word_generator<Gen> and detail::has_bulk_generate<Gen>::value )
+        rng_.generate ( out_, n_ );
+    else
+        for ( std::size_t i = 0u; i < n_; ++i )
+            out_[ i ] = word ( rng_ );
+}
+
+// [ 0, 1 ), all 53 (24) bits of the mantissa filled.
+template<typename RealType>
+[[nodiscard]] constexpr RealType canonical ( std::uint64_t w_ ) noexcept {
+    if constexpr ( std::is_same<RealType, float>::value )
+        return static_cast<float> ( w_ >> 40 ) * 0x1.0p-24f;
+    else
+        return static_cast<double> ( w_ >> 11 ) * 0x1.0p-53;
+}
+
+// Calls f_ ( w ) for the values in [ first_, last_ ), with w a block of 64-bit words.
+template<typename Gen, typename OutputIt, typename Function>
+void generate_blocks ( Gen & rng_, OutputIt first_, OutputIt last_, Function f_ ) {
+    constexpr std::size_t block_size = 256u;
+    std::uint64_t block[ block_size ];
+    while ( first_ != last_ ) {
+        std::size_t n = 0u;
+        if constexpr ( std::is_base_of<std::random_access_iterator_tag,
+                                       typename std::iterator_traits<OutputIt>::iterator_category>::value )
+            n = std::min ( block_size, static_cast<std::size_t> ( last_ - first_ ) );
+        else
+            for ( OutputIt it = first_; n < block_size and it != last_; ++it )
+                ++n;
+        words ( rng_, block, n );
+        for ( std::size_t i = 0u; i < n; ++i, ++first_ )
+            *first_ = f_ ( block[ i ] );
+    }
+}
+
+// The words of a generator, drawn in blocks, for values which take one or more words each. No more words are drawn
+// ahead than values are still to be completed, the generator is left where repeated calls to operator ( ) leave it.
+template<typename Gen>
+class word_block {
+    static constexpr std::size_t block_size = 256u;
+
+    Gen & rng_;
+    std::size_t values_, index_ = 0u, size_ = 0u;
+    std::uint64_t block_[ block_size ];
+
+    public:
+    using result_type = std::uint64_t;
+
+    static constexpr result_type min ( ) noexcept { return 0u; }
+    static constexpr result_type max ( ) noexcept { return std::numeric_limits<std::uint64_t>::max ( ); }
+
+    word_block ( Gen & rng_, std::size_t values_ ) noexcept : rng_ ( rng_ ), values_ ( values_ ) {}
+
+    result_type operator( ) ( ) {
+        if ( index_ == size_ ) {
+            assert ( values_ );
+            size_  = std::min ( block_size, values_ );
+            index_ = 0u;
+            words ( rng_, block_, size_ );
+        }
+        return block_[ index_++ ];
+    }
+
+    // A value is complete.
+    void pop ( ) noexcept { --values_; }
+};
+
+// Assigns f_ ( words ) to the values in [ first_, last_ ), with words a word_block, in order.
+template<typename Gen, typename OutputIt, typename Function>
+void generate_words ( Gen & rng_, OutputIt first_, OutputIt last_, Function f_ ) {
+    word_block<Gen> words ( rng_, static_cast<std::size_t> ( std::distance ( first_, last_ ) ) );
+    for ( ; first_ != last_; ++first_, words.pop ( ) )
+        *first_ = f_ ( words );
+}
+
+} // namespace real_detail
+
+// Uniform on [ a, b ), a + ( b - a ) * u, with u having all bits of the mantissa random.
+template<typename RealType = double>
+class uniform_real_distribution {
+    static_assert ( std::is_floating_point<RealType>::value and sizeof ( RealType ) <= sizeof ( double ),
+                    "only float and double result_types are allowed." );
+
+    RealType a_, b_, range_;
+
+    public:
+    using result_type = RealType;
+
+    explicit uniform_real_distribution ( result_type a = result_type ( 0 ), result_type b = result_type ( 1 ) ) noexcept :
+        a_ ( a ), b_ ( b ), range_ ( b - a ) {
+        assert ( a <= b );
+    }
+
+    void reset ( ) const noexcept {}
+
+    [[nodiscard]] result_type a ( ) const noexcept { return a_; }
+    [[nodiscard]] result_type b ( ) const noexcept { return b_; }
+    [[nodiscard]] result_type min ( ) const noexcept { return a_; }
+    [[nodiscard]] result_type max ( ) const noexcept { return b_; }
+
+    template<typename Gen>
+    [[nodiscard]] result_type operator( ) ( Gen & rng ) const {
+        return a_ + real_detail::rounded ( range_ * real_detail::canonical<result_type> ( real_detail::word ( rng ) ) );
+    }
+
+    // Fills [ first, last ), the same sequence as repeated calls to operator ( ).
+    template<typename Gen, typename OutputIt>
+    void generate ( Gen & rng, OutputIt first, OutputIt last ) const {
+        real_detail::generate_blocks ( rng, first, last, [ a = a_, range = range_ ] ( std::uint64_t w ) {
+            return a + real_detail::rounded ( range * real_detail::canonical<result_type> ( w ) );
+        } );
+    }
+
+    [[nodiscard]] bool operator== ( uniform_real_distribution const & rhs ) const noexcept {
+        return a_ == rhs.a_ and b_ == rhs.b_;
+    }
+    [[nodiscard]] bool operator!= ( uniform_real_distribution const & rhs ) const noexcept { return not( *this == rhs ); }
+};
+
+} // namespace sax
+
+#if defined( __clang__ )
+#pragma float_control( pop )
+#endif
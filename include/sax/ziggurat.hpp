@@ -0,0 +1,322 @@
+
+// MIT License
+//
+// Copyright (c) 2020 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include <array>
+#include <limits>
+#include <type_traits>
+
+#include "uniform_real_distribution.hpp"
+
+// Normal and exponential distributions, with the 256 layer ziggurat method of Marsaglia and Tsang (2000), as refined
+// by Doornik (2005): the layer and the abscissa come from one 64-bit word, ~99% of the values take one multiply and
+// one compare. The tables are computed at compile time and the rare wedge and tail paths use the exp and log below,
+// which only use IEEE basic arithmetic, the output is the same with any compiler or standard library (see
+// uniform_real_distribution.hpp, products by powers of 2 are exact and need not be rounded).
+
+#if defined( __clang__ )
+#pragma float_control( push )
+#pragma clang fp contract( off )
+#endif
+
+namespace sax {
+
+namespace ziggurat_detail {
+
+inline constexpr double ln2_hi = 6.93147180369123816490e-01, ln2_lo = 1.90821492927058770002e-10;
+
+// Multiplies x_ by 2 ^ e_, exactly (barring under/overflow).
+[[nodiscard]] constexpr double scale ( double x_, int e_ ) noexcept {
+    for ( ; e_ >= 32; e_ -= 32 )
+        x_ *= 0x1.0p32;
+    for ( ; e_ <= -32; e_ += 32 )
+        x_ *= 0x1.0p-32;
+    for ( ; e_ > 0; --e_ )
+        x_ *= 2.0;
+    for ( ; e_ < 0; ++e_ )
+        x_ *= 0.5;
+    return x_;
+}
+
+template<int N, typename F>
+[[nodiscard]] constexpr std::array<double, N> make_coefficients ( F f_ ) noexcept {
+    std::array<double, N> c{ };
+    for ( int i = 0; i < N; ++i )
+        c[ i ] = f_ ( i );
+    return c;
+}
+
+// 1 / ( 2k + 1 ).
+inline constexpr std::array<double, 28> log_coefficients = make_coefficients<28> ( [] ( int k ) { return 1.0 / ( 2 * k + 1 ); } );
+
+// 1 / i!.
+inline constexpr std::array<double, 21> exp_coefficients = make_coefficients<21> ( [] ( int i ) {
+    double f = 1.0;
+    for ( int j = 2; j <= i; ++j )
+        f *= j;
+    return 1.0 / f;
+} );
+
+// Natural log, x_ > 0 (and finite).
+[[nodiscard]] constexpr double log ( double x_ ) noexcept {
+    int e = 0;
+    for ( ; x_ < 0x1.0p-32; e -= 32 )
+        x_ *= 0x1.0p32;
+    for ( ; x_ > 0x1.0p32; e += 32 )
+        x_ *= 0x1.0p-32;
+    for ( ; x_ > 1.4142135623730951; ++e )
+        x_ *= 0.5;
+    for ( ; x_ < 0.7071067811865476; --e )
+        x_ *= 2.0;
+    // log ( x ) = 2 atanh ( s ), | s | < 0.1716.
+    double const s = ( x_ - 1.0 ) / ( x_ + 1.0 ), s2 = s * s;
+    double sum     = 0.0;
+    for ( int k = 27; k >= 0; --k )
+        sum = log_coefficients[ k ] + real_detail::rounded ( s2 * sum );
+    return real_detail::rounded ( e * ln2_hi ) + ( real_detail::rounded ( e * ln2_lo ) + real_detail::rounded ( 2.0 * s * sum ) );
+}
+
+// e ^ x_.
+[[nodiscard]] constexpr double exp ( double x_ ) noexcept {
+    if ( x_ < -746.0 )
+        return 0.0;
+    if ( x_ > 710.0 )
+        return std::numeric_limits<double>::infinity ( );
+    // x = k ln 2 + r, | r | <= ln 2 / 2.
+    int const k    = static_cast<int> ( real_detail::rounded ( x_ * 1.4426950408889634 ) + ( x_ < 0.0 ? -0.5 : 0.5 ) );
+    double const r = ( x_ - real_detail::rounded ( k * ln2_hi ) ) - real_detail::rounded ( k * ln2_lo );
+    double sum     = 0.0;
+    for ( int i = 20; i >= 0; --i )
+        sum = exp_coefficients[ i ] + real_detail::rounded ( r * sum );
+    return scale ( sum, k );
+}
+
+[[nodiscard]] constexpr double sqrt ( double x_ ) noexcept {
+    if ( x_ <= 0.0 )
+        return 0.0;
+    double y = x_ > 1.0 ? x_ : 1.0;
+    for ( int i = 0; i < 1100; ++i ) { // Newton, monotone from above.
+        double const z = 0.5 * ( y + x_ / y );
+        if ( z >= y )
+            break;
+        y = z;
+    }
+    return y;
+}
+
+inline constexpr int layers = 256;
+
+struct table {
+    std::array<double, layers + 1> x, f;
+};
+
+// r_ is the start of the tail, v_ the area of each layer, f_ the (unnormalized, decreasing, f_ ( 0 ) == 1) density,
+// f_inv_ its inverse.
+template<typename F, typename FInv>
+[[nodiscard]] constexpr table make_table ( double r_, double v_, F f_, FInv f_inv_ ) noexcept {
+    table t{ };
+    t.x[ 0 ] = v_ / f_ ( r_ );
+    t.x[ 1 ] = r_;
+    for ( int i = 1; i < layers - 1; ++i )
+        t.x[ i + 1 ] = f_inv_ ( v_ / t.x[ i ] + f_ ( t.x[ i ] ) );
+    t.x[ layers ] = 0.0;
+    for ( int i = 0; i <= layers; ++i )
+        t.f[ i ] = f_ ( t.x[ i ] );
+    return t;
+}
+
+[[nodiscard]] constexpr double normal_pdf ( double x_ ) noexcept { return exp ( -0.5 * x_ * x_ ); }
+[[nodiscard]] constexpr double exponential_pdf ( double x_ ) noexcept { return exp ( -x_ ); }
+
+inline constexpr double normal_r = 3.6541528853610088, exponential_r = 7.6971174701310500;
+
+inline constexpr table normal_table = make_table ( normal_r, 4.928673233974658e-03, normal_pdf,
+                                                   [] ( double y ) { return sqrt ( -2.0 * log ( y ) ); } );
+
+inline constexpr table exponential_table = make_table ( exponential_r, 3.949659822581556e-03, exponential_pdf,
+                                                        [] ( double y ) { return -log ( y ); } );
+
+// ( 0, 1 ).
+template<typename Gen>
+[[nodiscard]] double open_unit ( Gen & rng_ ) {
+    return ( static_cast<double> ( real_detail::word ( rng_ ) >> 11 ) + 0.5 ) * 0x1.0p-53;
+}
+
+template<typename Gen>
+[[nodiscard]] double normal_slow ( Gen & rng_, std::uint64_t w_ );
+
+// A standard normal variate, w_ is the first word, more are drawn from rng_ if needed.
+template<typename Gen>
+[[nodiscard]] inline double normal ( Gen & rng_, std::uint64_t w_ ) {
+    std::size_t const i = w_ & ( layers - 1 );
+    double const x      = ( static_cast<double> ( w_ >> 11 ) * 0x1.0p-52 - 1.0 ) * normal_table.x[ i ]; // [ -1, 1 ) x[ i ].
+    if ( ( x < 0.0 ? -x : x ) < normal_table.x[ i + 1 ] )
+        return x;
+    return normal_slow ( rng_, w_ );
+}
+
+template<typename Gen>
+[[nodiscard]] double normal_slow ( Gen & rng_, std::uint64_t w_ ) {
+    table const & t = normal_table;
+    for ( ;; ) {
+        std::size_t const i = w_ & ( layers - 1 );
+        double const u      = static_cast<double> ( w_ >> 11 ) * 0x1.0p-52 - 1.0;
+        double const x      = u * t.x[ i ];
+        if ( ( x < 0.0 ? -x : x ) < t.x[ i + 1 ] )
+            return x;
+        if ( not i ) { // The tail, Marsaglia (1964).
+            double a, b;
+            do {
+                a = -log ( open_unit ( rng_ ) ) / normal_r;
+                b = -log ( open_unit ( rng_ ) );
+            } while ( b + b < a * a );
+            return u < 0.0 ? -normal_r - a : normal_r + a;
+        }
+        if ( t.f[ i + 1 ] + real_detail::rounded ( ( t.f[ i ] - t.f[ i + 1 ] ) *
+                                                   real_detail::canonical<double> ( real_detail::word ( rng_ ) ) ) <
+             normal_pdf ( x ) )
+            return x;
+        w_ = real_detail::word ( rng_ );
+    }
+}
+
+template<typename Gen>
+[[nodiscard]] double exponential_slow ( Gen & rng_, std::uint64_t w_ );
+
+// A standard exponential variate, w_ is the first word, more are drawn from rng_ if needed.
+template<typename Gen>
+[[nodiscard]] inline double exponential ( Gen & rng_, std::uint64_t w_ ) {
+    std::size_t const i = w_ & ( layers - 1 );
+    double const x      = real_detail::canonical<double> ( w_ ) * exponential_table.x[ i ];
+    if ( x < exponential_table.x[ i + 1 ] )
+        return x;
+    return exponential_slow ( rng_, w_ );
+}
+
+template<typename Gen>
+[[nodiscard]] double exponential_slow ( Gen & rng_, std::uint64_t w_ ) {
+    table const & t = exponential_table;
+    double tail     = 0.0; // The exponential is memoryless, the tail is the distribution itself, shifted.
+    for ( ;; ) {
+        std::size_t const i = w_ & ( layers - 1 );
+        double const x      = real_detail::canonical<double> ( w_ ) * t.x[ i ];
+        if ( x < t.x[ i + 1 ] )
+            return tail + x;
+        if ( not i )
+            tail += exponential_r;
+        else if ( t.f[ i + 1 ] + real_detail::rounded ( ( t.f[ i ] - t.f[ i + 1 ] ) *
+                                                        real_detail::canonical<double> ( real_detail::word ( rng_ ) ) ) <
+                  exponential_pdf ( x ) )
+            return tail + x;
+        w_ = real_detail::word ( rng_ );
+    }
+}
+
+} // namespace ziggurat_detail
+
+template<typename RealType = double>
+class normal_distribution {
+    static_assert ( std::is_floating_point<RealType>::value and sizeof ( RealType ) <= sizeof ( double ),
+                    "only float and double result_types are allowed." );
+
+    double mean_, stddev_;
+
+    public:
+    using result_type = RealType;
+
+    explicit normal_distribution ( result_type mean = result_type ( 0 ), result_type stddev = result_type ( 1 ) ) noexcept :
+        mean_ ( mean ), stddev_ ( stddev ) {
+        assert ( stddev > result_type ( 0 ) );
+    }
+
+    void reset ( ) const noexcept {}
+
+    [[nodiscard]] result_type mean ( ) const noexcept { return static_cast<result_type> ( mean_ ); }
+    [[nodiscard]] result_type stddev ( ) const noexcept { return static_cast<result_type> ( stddev_ ); }
+    [[nodiscard]] result_type min ( ) const noexcept { return std::numeric_limits<result_type>::lowest ( ); }
+    [[nodiscard]] result_type max ( ) const noexcept { return std::numeric_limits<result_type>::max ( ); }
+
+    template<typename Gen>
+    [[nodiscard]] result_type operator( ) ( Gen & rng ) const {
+        return static_cast<result_type> (
+            mean_ + real_detail::rounded ( stddev_ * ziggurat_detail::normal ( rng, real_detail::word ( rng ) ) ) );
+    }
+
+    // Fills [ first, last ), the words are drawn in blocks, the same sequence as repeated calls to operator ( ).
+    template<typename Gen, typename OutputIt>
+    void generate ( Gen & rng, OutputIt first, OutputIt last ) const {
+        real_detail::generate_words ( rng, first, last, [ this ] ( auto & words ) { return operator( ) ( words ); } );
+    }
+
+    [[nodiscard]] bool operator== ( normal_distribution const & rhs ) const noexcept {
+        return mean_ == rhs.mean_ and stddev_ == rhs.stddev_;
+    }
+    [[nodiscard]] bool operator!= ( normal_distribution const & rhs ) const noexcept { return not( *this == rhs ); }
+};
+
+template<typename RealType = double>
+class exponential_distribution {
+    static_assert ( std::is_floating_point<RealType>::value and sizeof ( RealType ) <= sizeof ( double ),
+                    "only float and double result_types are allowed." );
+
+    double lambda_, beta_;
+
+    public:
+    using result_type = RealType;
+
+    explicit exponential_distribution ( result_type lambda = result_type ( 1 ) ) noexcept :
+        lambda_ ( lambda ), beta_ ( 1.0 / static_cast<double> ( lambda ) ) {
+        assert ( lambda > result_type ( 0 ) );
+    }
+
+    void reset ( ) const noexcept {}
+
+    [[nodiscard]] result_type lambda ( ) const noexcept { return static_cast<result_type> ( lambda_ ); }
+    [[nodiscard]] result_type min ( ) const noexcept { return result_type ( 0 ); }
+    [[nodiscard]] result_type max ( ) const noexcept { return std::numeric_limits<result_type>::max ( ); }
+
+    template<typename Gen>
+    [[nodiscard]] result_type operator( ) ( Gen & rng ) const {
+        return static_cast<result_type> ( beta_ * ziggurat_detail::exponential ( rng, real_detail::word ( rng ) ) );
+    }
+
+    // Fills [ first, last ), the words are drawn in blocks, the same sequence as repeated calls to operator ( ).
+    template<typename Gen, typename OutputIt>
+    void generate ( Gen & rng, OutputIt first, OutputIt last ) const {
+        real_detail::generate_words ( rng, first, last, [ this ] ( auto & words ) { return operator( ) ( words ); } );
+    }
+
+    [[nodiscard]] bool operator== ( exponential_distribution const & rhs ) const noexcept { return lambda_ == rhs.lambda_; }
+    [[nodiscard]] bool operator!= ( exponential_distribution const & rhs ) const noexcept { return not( *this == rhs ); }
+};
+
+} // namespace sax
+
+#if defined( __clang__ )
+#pragma float_control( pop )
+#endif